@@ -0,0 +1,51 @@
+// Microbenchmark : noyaux de De Casteljau déroulés par degré contre la boucle générique.
+// Construction : cmake -DBEZIER_BUILD_BENCHMARKS=ON, cible bench_degree_kernels.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "BezierCurve.hpp"
+
+namespace {
+
+constexpr int kSamples = 1 << 20;
+
+template <typename F>
+double nanosecondsPerSample(F&& evaluate, glm::vec2& sink) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSamples; ++i)
+        sink += evaluate(i / (float)kSamples);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kSamples;
+}
+
+}
+
+int main() {
+    glm::vec2 sink(0.0f);
+    std::printf("degré  générique (ns)  De Casteljau fixe (ns)  accél.  Bernstein fixe (ns)  accél.\n");
+
+    for (std::size_t n = 2; n <= BezierCurve2f::kMaxFixedPoints; ++n) {
+        std::vector<glm::vec2> points(n);
+        for (std::size_t i = 0; i < n; ++i)
+            points[i] = glm::vec2(std::cos(i * 1.3f), std::sin(i * 2.1f));
+
+        std::vector<glm::vec2> temp(n);
+        const double generic = nanosecondsPerSample([&](float t) {
+            std::copy(points.begin(), points.end(), temp.begin());
+            return BezierCurve2f::deCasteljauInPlace(temp.data(), n, t);
+        }, sink);
+
+        const BezierCurve2f::Kernel fixedKernel = BezierCurve2f::deCasteljauKernel(n);
+        const double fixed = nanosecondsPerSample([&](float t) { return fixedKernel(points.data(), t); }, sink);
+
+        const BezierCurve2f::Kernel bernstein = BezierCurve2f::bernsteinKernel(n);
+        const double direct = nanosecondsPerSample([&](float t) { return bernstein(points.data(), t); }, sink);
+
+        std::printf("%5zu  %14.2f  %22.2f  %5.2fx  %19.2f  %5.2fx\n",
+                    n - 1, generic, fixed, generic / fixed, direct, generic / direct);
+    }
+
+    std::printf("(somme de contrôle %g)\n", sink.x + sink.y);
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Microbenchmark : sampleCurvesParallel sur un pool de 1 à N threads (N = premier argument, sinon
+// le nombre de cœurs), contre la boucle séquentielle de sampleUniform, sur beaucoup de courbes
+// de degrés mêlés.
+// Chaque passage est aussi comparé au résultat séquentiel, qui doit être identique au bit près.
+// Construction : cmake -DBEZIER_BUILD_BENCHMARKS=ON, cible bench_parallel_sampling.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "BezierCurveData.hpp"
+#include "ParallelSampling.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+
+constexpr std::size_t kCurves = 2000;
+constexpr int kSegments = 200;
+constexpr int kRepeats = 5;
+
+// Surtout des cubiques, quelques courbes de degré moyen et de rares courbes de haut degré,
+// que sampleCurvesParallel découpe en plages de paramètres
+std::vector<BezierCurveData> makeCurves() {
+    std::vector<BezierCurveData> curves(kCurves);
+    for (std::size_t c = 0; c < curves.size(); ++c) {
+        const std::size_t n = c % 100 == 0 ? 48 : c % 10 == 0 ? 12 : 4;
+        for (std::size_t i = 0; i < n; ++i)
+            curves[c].addControlPoint(glm::vec2(std::cos(i * 1.3f + c), std::sin(i * 2.1f - c)));
+    }
+    return curves;
+}
+
+template <typename F>
+double bestMilliseconds(F&& run) {
+    double best = 1e30;
+    for (int r = 0; r < kRepeats; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::vector<BezierCurveData> curves = makeCurves();
+    const unsigned maxThreads = argc > 1 ? (unsigned)std::max(1, std::atoi(argv[1]))
+                                         : std::max(1u, std::thread::hardware_concurrency());
+
+    for (BezierMethod method : {BezierMethod::DeCasteljau, BezierMethod::Simd}) {
+        const char* name = method == BezierMethod::Simd ? "SIMD" : "De Casteljau";
+        for (const auto& curve : curves) curve.prepareCaches(method);
+
+        // Référence : la boucle séquentielle, dans le même tampon que sampleCurvesParallel
+        SampledCurves reference;
+        ThreadPool single(1);
+        sampleCurvesParallel(curves, kSegments, method, reference, single);
+        const double sequential = bestMilliseconds([&] {
+            for (std::size_t i = 0; i < curves.size(); ++i)
+                curves[i].sampleUniform(kSegments, &reference.points[reference.offsets[i]], method);
+        });
+
+        std::printf("%s, %zu courbes, %d segments : boucle séquentielle %.2f ms\n", name, curves.size(),
+                    kSegments, sequential);
+        std::printf("threads  temps (ms)  accél.  identique\n");
+        for (unsigned threads = 1; threads <= maxThreads; ++threads) {
+            ThreadPool pool(threads);
+            SampledCurves out;
+            const double elapsed = bestMilliseconds([&] { sampleCurvesParallel(curves, kSegments, method, out, pool); });
+            const bool same = out.offsets == reference.offsets &&
+                              std::memcmp(out.points.data(), reference.points.data(),
+                                          out.points.size() * sizeof(glm::vec2)) == 0;
+            std::printf("%7u  %10.2f  %5.2fx  %s\n", threads, elapsed, sequential / elapsed, same ? "oui" : "NON");
+            if (!same) return 1;
+        }
+    }
+    return 0;
+}
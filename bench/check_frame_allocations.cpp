@@ -0,0 +1,112 @@
+// Vérification : le chemin d'échantillonnage parcouru à chaque image (refreshSampleCaches puis
+// BezierCurveData::sampled, c'est-à-dire generateCurvePoints dans main.cpp) ne fait plus aucune
+// allocation une fois les tampons à leur taille. Un operator new compteur remplace celui de la
+// bibliothèque ; des passages de glisser-déposer amorcent les tampons, le suivant doit rejouer
+// les mêmes images sans un seul appel à new.
+// Construction : cmake -DBEZIER_BUILD_BENCHMARKS=ON, cible check_frame_allocations.
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "BezierCurveData.hpp"
+#include "ParallelSampling.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+constexpr int kFrames = 120;
+constexpr int kWarmupPasses = 8;
+
+std::vector<BezierCurveData> makeCurves() {
+    // Degrés 3, 6 et 40 : noyaux déroulés et tampon de travail générique
+    std::vector<BezierCurveData> curves(3);
+    const std::size_t sizes[] = {4, 7, 41};
+    for (std::size_t c = 0; c < curves.size(); ++c)
+        for (std::size_t i = 0; i < sizes[c]; ++i) {
+            const float u = i / (float)(sizes[c] - 1);
+            curves[c].addControlPoint(glm::vec2(2.0f * u - 1.0f, 0.5f * std::sin(7.0f * u + c)));
+        }
+    curves[1].applyTransformation(glm::mat3(0.8f, 0.1f, 0.0f, -0.1f, 0.8f, 0.0f, 0.05f, 0.0f, 1.0f));
+    return curves;
+}
+
+// Une image : un point d'une courbe suit la souris, puis l'affichage relit les polylignes
+void frame(std::vector<BezierCurveData>& curves, int f, const SamplingOptions& options, ThreadPool& pool) {
+    BezierCurveData& dragged = curves[f % curves.size()];
+    dragged.controlPoints[1] = glm::vec2(-0.5f + 0.01f * f, 0.4f * std::cos(0.2f * f));
+    dragged.markModified();
+    // De temps en temps toutes les courbes changent (transformation globale) : plusieurs tâches
+    if (f % 8 == 0)
+        for (auto& curve : curves) curve.markModified();
+
+    refreshSampleCaches(curves, options, pool);
+    for (const auto& curve : curves) {
+        const std::vector<glm::vec2>& pts = curve.sampled(options);
+        if (!pts.empty() && !std::isfinite(pts.back().x)) std::abort();
+    }
+}
+
+bool checkFlat(const char* label, const SamplingOptions& options, ThreadPool& pool) {
+    std::vector<BezierCurveData> curves = makeCurves();
+    // Amorçage : les tampons thread_local d'un thread ne grandissent que lorsqu'il reçoit une
+    // courbe plus grosse que les précédentes, ce qui dépend du vol de tâches ; on rejoue le
+    // glisser-déposer jusqu'à un passage sans allocation.
+    for (int pass = 0; pass < kWarmupPasses; ++pass) {
+        const std::size_t start = allocations.load();
+        for (int f = 0; f < kFrames; ++f) frame(curves, f, options, pool);
+        if (pass > 0 && allocations.load() == start) break;
+    }
+
+    const std::size_t before = allocations.load();
+    for (int f = 0; f < kFrames; ++f) frame(curves, f, options, pool);
+    const std::size_t count = allocations.load() - before;
+
+    std::printf("%-28s %2u thread(s) : %zu allocation(s) sur %d images\n", label, pool.size(), count, kFrames);
+    return count == 0;
+}
+
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    struct Case {
+        const char* label;
+        SamplingMode mode;
+        BezierMethod method;
+    };
+    const Case cases[] = {
+        {"uniforme / De Casteljau", SamplingMode::Uniform, BezierMethod::DeCasteljau},
+        {"uniforme / formule directe", SamplingMode::Uniform, BezierMethod::DirectFormula},
+        {"uniforme / SIMD", SamplingMode::Uniform, BezierMethod::Simd},
+        {"uniforme / différences", SamplingMode::Uniform, BezierMethod::ForwardDifference},
+        {"uniforme / Horner", SamplingMode::Uniform, BezierMethod::Horner},
+        {"adaptatif", SamplingMode::Adaptive, BezierMethod::DeCasteljau},
+        {"abscisse curviligne", SamplingMode::ArcLength, BezierMethod::DeCasteljau},
+    };
+
+    ThreadPool serial(1);
+    ThreadPool parallel(4);
+    bool ok = true;
+    for (ThreadPool* pool : {&serial, &parallel})
+        for (const Case& c : cases) {
+            SamplingOptions options;
+            options.mode = c.mode;
+            options.method = c.method;
+            ok = checkFlat(c.label, options, *pool) && ok;
+        }
+
+    std::printf(ok ? "OK\n" : "ÉCHEC : allocations pendant les images\n");
+    return ok ? 0 : 1;
+}
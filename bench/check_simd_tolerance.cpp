@@ -0,0 +1,92 @@
+// Vérification : BezierMethod::Simd reste à kSimdBezierTolerance près de BezierMethod::DeCasteljau
+// (écart relatif à l'étendue des points de contrôle), pour tous les degrés jusqu'à 40 et des lots
+// dont la taille n'est pas multiple de 4 ou de 8, afin de passer par les queues de lot SSE et AVX2.
+// Construction : cmake -DBEZIER_BUILD_BENCHMARKS=ON, cible check_simd_tolerance.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "BezierCurveData.hpp"
+#include "BezierSimd.hpp"
+
+namespace {
+
+constexpr std::size_t kMaxPoints = 41;
+constexpr std::size_t kMaxBatch = 37;
+
+BezierCurveData makeCurve(std::size_t n, bool transformed) {
+    BezierCurveData curve;
+    for (std::size_t i = 0; i < n; ++i)
+        curve.addControlPoint(glm::vec2(3.0f * std::cos(i * 1.3f) + 0.5f * i, 2.0f * std::sin(i * 2.1f)));
+    if (transformed) curve.applyTransformation(glm::mat3(0.8f, 0.3f, 0.0f, -0.3f, 0.8f, 0.0f, 1.5f, -0.5f, 1.0f));
+    return curve;
+}
+
+// Plus grand côté de la boîte englobante des points de contrôle transformés
+float extent(const BezierCurveData& curve) {
+    const std::vector<glm::vec2>& points = curve.worldControlPoints();
+    glm::vec2 lo = points.front(), hi = points.front();
+    for (const glm::vec2& p : points) {
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    return std::max(std::max(hi.x - lo.x, hi.y - lo.y), 1e-30f);
+}
+
+float maxError(const std::vector<glm::vec2>& a, const std::vector<glm::vec2>& b, std::size_t count) {
+    float error = 0.0f;
+    for (std::size_t k = 0; k < count; ++k)
+        error = std::max(error, std::max(std::abs(a[k].x - b[k].x), std::abs(a[k].y - b[k].y)));
+    return error;
+}
+
+}
+
+int main() {
+    std::printf("jeu d'instructions : %s, tolérance relative %g\n", simdLevelName(detectSimdLevel()),
+                kSimdBezierTolerance);
+
+    std::vector<float> ts(kMaxBatch);
+    std::vector<glm::vec2> reference(kMaxBatch + 1), simd(kMaxBatch + 1);
+    float worst = 0.0f;
+    std::size_t worstPoints = 0, worstCount = 0;
+
+    for (bool transformed : {false, true})
+        for (std::size_t n = 2; n <= kMaxPoints; ++n) {
+            const BezierCurveData curve = makeCurve(n, transformed);
+            const float scale = extent(curve);
+
+            // Lots de 1 à kMaxBatch paramètres, extrémités comprises
+            for (std::size_t count = 1; count <= kMaxBatch; ++count) {
+                for (std::size_t k = 0; k < count; ++k) ts[k] = count == 1 ? 0.5f : k / (float)(count - 1);
+                curve.evaluateMany(ts.data(), count, reference.data(), BezierMethod::DeCasteljau);
+                curve.evaluateMany(ts.data(), count, simd.data(), BezierMethod::Simd);
+                const float error = maxError(reference, simd, count) / scale;
+                if (error > worst) {
+                    worst = error;
+                    worstPoints = n;
+                    worstCount = count;
+                }
+            }
+
+            // Échantillonnage uniforme : segments + 1 points
+            for (int segments = 1; segments < (int)kMaxBatch; ++segments) {
+                curve.sampleUniform(segments, reference.data(), BezierMethod::DeCasteljau);
+                curve.sampleUniform(segments, simd.data(), BezierMethod::Simd);
+                const float error = maxError(reference, simd, segments + 1) / scale;
+                if (error > worst) {
+                    worst = error;
+                    worstPoints = n;
+                    worstCount = segments + 1;
+                }
+            }
+        }
+
+    const bool ok = worst <= kSimdBezierTolerance;
+    if (worst > 0.0f)
+        std::printf("écart relatif maximal %g (degré %zu, lot de %zu)\n", worst, worstPoints - 1, worstCount);
+    else
+        std::printf("écart relatif maximal 0\n");
+    std::printf(ok ? "OK\n" : "ÉCHEC : écart SIMD au-delà de la tolérance\n");
+    return ok ? 0 : 1;
+}
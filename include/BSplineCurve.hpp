@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "BezierCurveData.hpp"
+
+// Courbe B-spline rationnelle (NURBS) de degré p fixé : chaque point de contrôle n'influence que
+// p + 1 intervalles de nœuds. Une évaluation (de Boor) coûte O(p²) quel que soit le nombre de
+// points, et déplacer un point ne rééchantillonne que les intervalles qu'il touche.
+class BSplineCurve {
+public:
+    static constexpr int kMaxDegree = 7;
+
+    explicit BSplineCurve(int degree = 3);
+
+    int degree() const { return p; }
+    // Change le degré ; les nœuds repassent en uniforme « clampé » (interpolation des extrémités).
+    void setDegree(int degree);
+
+    const std::vector<glm::vec2>& points() const { return controlPoints; }
+    const std::vector<float>& weights() const { return pointWeights; }
+    const std::vector<float>& knots() const { return knotVector; }
+
+    void addControlPoint(const glm::vec2& point, float weight = 1.0f);
+    // Modifications locales : seuls les intervalles [i, i + p] sont invalidés.
+    void setControlPoint(std::size_t index, const glm::vec2& point);
+    void setWeight(std::size_t index, float weight);
+    // Vecteur de nœuds explicite (n + p + 1 valeurs croissantes). Refusé s'il est invalide.
+    bool setKnots(const std::vector<float>& knots);
+    void clear();
+
+    // Au moins p + 1 points sont nécessaires pour définir la courbe.
+    bool valid() const { return controlPoints.size() > static_cast<std::size_t>(p); }
+    std::uint64_t version() const { return editVersion; }
+
+    // u dans [0, 1], ramené au domaine [knots[p], knots[n]].
+    glm::vec2 evaluate(float u) const;
+
+    // Uniform / ArcLength : options.segments points répartis sur les intervalles au prorata de leur
+    // longueur en paramètre (ArcLength n'est pas reparamétré) ; Adaptive : aplatissement par intervalle.
+    // options.method est ignoré, l'évaluation est toujours celle de de Boor.
+    void sample(const SamplingOptions& options, std::vector<glm::vec2>& out) const;
+    // Polyligne en cache : seuls les intervalles invalidés depuis le dernier appel sont recalculés.
+    const std::vector<glm::vec2>& sampled(const SamplingOptions& options) const;
+    // Nombre d'intervalles recalculés lors du dernier appel à sampled().
+    std::size_t lastResampledSpans() const { return resampledSpans; }
+
+private:
+    int p;
+    std::vector<glm::vec2> controlPoints;
+    std::vector<float> pointWeights;
+    std::vector<float> knotVector;
+    bool uniformKnots = true;  // nœuds générés automatiquement, recalculés à chaque ajout
+    std::uint64_t editVersion = 0;
+
+    mutable std::vector<std::vector<glm::vec2>> spanSamples;  // un bloc par intervalle [knots[k], knots[k+1]), k >= p
+    mutable std::vector<char> spanDirty;
+    mutable std::vector<glm::vec2> cachedSamples;
+    mutable SamplingOptions cachedSampling;
+    mutable bool samplesValid = false;
+    mutable std::size_t resampledSpans = 0;
+
+    void rebuildUniformKnots();
+    void invalidateAll();
+    void invalidateAround(std::size_t index);
+    std::size_t findSpan(float x) const;
+    glm::vec2 deBoor(std::size_t span, float x) const;
+    void sampleSpan(std::size_t span, const SamplingOptions& options, std::vector<glm::vec2>& out) const;
+};
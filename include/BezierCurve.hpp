@@ -0,0 +1,174 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Cœur d'évaluation générique : scalaire T (float ou double) et dimension Dim (2, 3, ou 4 pour
+// des points homogènes). Tout est résolu à la compilation, sans fonction virtuelle.
+// BezierCurveData en est la spécialisation 2D float, enrichie des outils d'édition et des caches.
+template <typename T, int Dim>
+class BezierCurve {
+public:
+    using Scalar = T;
+    using Point = glm::vec<Dim, T, glm::defaultp>;
+    static constexpr int dimension = Dim;
+
+    std::vector<Point> controlPoints;
+
+    BezierCurve() = default;
+    explicit BezierCurve(std::vector<Point> points) : controlPoints(std::move(points)) {}
+
+    // Réduction de De Casteljau sur place : pts[0] contient B(t) à la fin.
+    static Point deCasteljauInPlace(Point* pts, std::size_t n, T t) {
+        for (std::size_t level = n - 1; level > 0; --level) {
+            for (std::size_t i = 0; i < level; ++i) {
+                pts[i] = (1 - t) * pts[i] + t * pts[i + 1];
+            }
+        }
+        return pts[0];
+    }
+
+    // Noyaux à nombre de points N fixé à la compilation : boucles à bornes constantes que le
+    // compilateur déroule entièrement, mêmes opérations dans le même ordre que le cas générique.
+    template <std::size_t N>
+    static Point deCasteljauFixed(const Point* cp, T t) {
+        Point p[N];
+        for (std::size_t i = 0; i < N; ++i) p[i] = cp[i];
+        for (std::size_t level = N - 1; level > 0; --level)
+            for (std::size_t i = 0; i < level; ++i)
+                p[i] = (1 - t) * p[i] + t * p[i + 1];
+        return p[0];
+    }
+
+    // Forme de Bernstein avec coefficients binomiaux constants, accumulée en précision Acc.
+    template <std::size_t N, typename Acc = T>
+    static Point bernsteinFixed(const Point* cp, T t) {
+        using AccPoint = glm::vec<Dim, Acc, glm::defaultp>;
+        const Acc u = Acc(t), s = Acc(1) - u;
+        Acc tPow[N], sPow[N];
+        tPow[0] = sPow[0] = Acc(1);
+        for (std::size_t i = 1; i < N; ++i) {
+            tPow[i] = tPow[i - 1] * u;
+            sPow[i] = sPow[i - 1] * s;
+        }
+        static constexpr std::array<std::size_t, N> coefficients = binomialRow<N>();
+        AccPoint result(Acc(0));
+        for (std::size_t i = 0; i < N; ++i)
+            result += (Acc(coefficients[i]) * tPow[i] * sPow[N - 1 - i]) * AccPoint(cp[i]);
+        return Point(result);
+    }
+
+    using Kernel = Point (*)(const Point*, T);
+    static constexpr std::size_t kMaxFixedPoints = 9;  // degrés 1 à 8
+
+    // Table de dispatch sur le nombre de points de contrôle ; nullptr au-delà (chemin générique).
+    static Kernel deCasteljauKernel(std::size_t n) {
+        static constexpr Kernel table[kMaxFixedPoints + 1] = {
+            nullptr, &deCasteljauFixed<1>, &deCasteljauFixed<2>, &deCasteljauFixed<3>, &deCasteljauFixed<4>,
+            &deCasteljauFixed<5>, &deCasteljauFixed<6>, &deCasteljauFixed<7>, &deCasteljauFixed<8>, &deCasteljauFixed<9>
+        };
+        return n <= kMaxFixedPoints ? table[n] : nullptr;
+    }
+
+    template <typename Acc = T>
+    static Kernel bernsteinKernel(std::size_t n) {
+        static constexpr Kernel table[kMaxFixedPoints + 1] = {
+            nullptr, &bernsteinFixed<1, Acc>, &bernsteinFixed<2, Acc>, &bernsteinFixed<3, Acc>,
+            &bernsteinFixed<4, Acc>, &bernsteinFixed<5, Acc>, &bernsteinFixed<6, Acc>,
+            &bernsteinFixed<7, Acc>, &bernsteinFixed<8, Acc>, &bernsteinFixed<9, Acc>
+        };
+        return n <= kMaxFixedPoints ? table[n] : nullptr;
+    }
+
+    // Ligne N - 1 du triangle de Pascal, calculée à la compilation
+    template <std::size_t N>
+    static constexpr std::array<std::size_t, N> binomialRow() {
+        std::array<std::size_t, N> row{};
+        row[0] = 1;
+        for (std::size_t k = 1; k < N; ++k) row[k] = row[k - 1] * (N - k) / k;
+        return row;
+    }
+
+    Point evaluate(T t) const {
+        Point p;
+        evaluateMany(&t, 1, &p);
+        return p;
+    }
+
+    void evaluateMany(const T* ts, std::size_t count, Point* out) const {
+        if (controlPoints.empty()) {
+            std::fill(out, out + count, Point(T(0)));
+            return;
+        }
+        if (Kernel kernel = deCasteljauKernel(controlPoints.size())) {
+            for (std::size_t k = 0; k < count; ++k)
+                out[k] = kernel(controlPoints.data(), ts[k]);
+            return;
+        }
+        Point* temp = scratch(controlPoints.size());
+        for (std::size_t k = 0; k < count; ++k) {
+            std::copy(controlPoints.begin(), controlPoints.end(), temp);
+            out[k] = deCasteljauInPlace(temp, controlPoints.size(), ts[k]);
+        }
+    }
+
+    // t = i / segments pour i = 0..segments ; out doit contenir segments + 1 éléments.
+    void sampleUniform(int segments, Point* out) const {
+        segments = std::max(segments, 1);
+        for (int i = 0; i <= segments; ++i) {
+            const T t = T(i) / T(segments);
+            evaluateMany(&t, 1, out + i);
+        }
+    }
+
+    // Courbe dérivée (hodographe) : Q_i = n (P_{i+1} - P_i)
+    BezierCurve derivativeCurve() const {
+        BezierCurve result;
+        if (controlPoints.size() < 2) return result;
+        const T degree = T(controlPoints.size() - 1);
+        result.controlPoints.resize(controlPoints.size() - 1);
+        for (std::size_t i = 0; i + 1 < controlPoints.size(); ++i)
+            result.controlPoints[i] = degree * (controlPoints[i + 1] - controlPoints[i]);
+        return result;
+    }
+
+    // Coupe la courbe en t : left couvre [0, t], right [t, 1].
+    void split(T t, BezierCurve& left, BezierCurve& right) const {
+        const std::size_t n = controlPoints.size();
+        left.controlPoints.resize(n);
+        right.controlPoints.resize(n);
+        if (n == 0) return;
+        Point* temp = scratch(n);
+        std::copy(controlPoints.begin(), controlPoints.end(), temp);
+        for (std::size_t level = 0; level < n; ++level) {
+            left.controlPoints[level] = temp[0];
+            right.controlPoints[n - 1 - level] = temp[n - 1 - level];
+            for (std::size_t i = 0; i + 1 < n - level; ++i)
+                temp[i] = (1 - t) * temp[i] + t * temp[i + 1];
+        }
+    }
+
+private:
+    // Tampon de travail par thread et par instanciation, agrandi seulement quand le degré augmente
+    static Point* scratch(std::size_t size) {
+        thread_local std::vector<Point> buffer;
+        if (buffer.size() < size) buffer.resize(size);
+        return buffer.data();
+    }
+};
+
+// Courbe rationnelle en coordonnées homogènes (x w, y w, z w, w) : évaluation puis projection.
+template <typename T>
+glm::vec<3, T, glm::defaultp> evaluateRational(const BezierCurve<T, 4>& curve, T t) {
+    const auto p = curve.evaluate(t);
+    return glm::vec<3, T, glm::defaultp>(p) / p.w;
+}
+
+using BezierCurve2f = BezierCurve<float, 2>;
+using BezierCurve2d = BezierCurve<double, 2>;
+using BezierCurve3f = BezierCurve<float, 3>;
+using BezierCurve3d = BezierCurve<double, 3>;
+using BezierCurve4f = BezierCurve<float, 4>;
+using BezierCurve4d = BezierCurve<double, 4>;
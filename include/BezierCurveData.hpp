@@ -1,20 +1,130 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
+#include "BezierCurve.hpp"
 
 enum class BezierMethod {
     DeCasteljau,
-    DirectFormula
+    DirectFormula,
+    Simd,              // De Casteljau vectorisé sur 4 (SSE) ou 8 (AVX2) paramètres, voir BezierSimd.hpp
+    ForwardDifference, // Différences avant, pas uniforme uniquement (sinon retombe sur De Casteljau)
+    Horner             // Base monomiale mise en cache à chaque modification, évaluée par Horner
 };
 
-class BezierCurveData {
+enum class SamplingMode {
+    Uniform,  // segments + 1 points à t régulier
+    Adaptive, // subdivision jusqu'à respecter la tolérance de planéité
+    ArcLength // segments + 1 points également espacés le long de la courbe
+};
+
+// Réglages d'échantillonnage partagés par l'affichage et les extrusions.
+struct SamplingOptions {
+    SamplingMode mode = SamplingMode::Uniform;
+    BezierMethod method = BezierMethod::DeCasteljau;
+    int segments = 100;
+    float tolerance = 0.002f;  // écart maximal courbe / polyligne, en unités des points de contrôle
+};
+
+// Compteurs du cache de polylignes (tous threads et toutes courbes confondus)
+struct SampleCacheStats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+};
+
+// Géométrie différentielle en un point : B(t), B'(t), B''(t) et courbure signée
+// κ = (B' × B'') / |B'|³ (0 là où la dérivée s'annule).
+struct CurveDifferential {
+    glm::vec2 position = glm::vec2(0.0f);
+    glm::vec2 firstDerivative = glm::vec2(0.0f);
+    glm::vec2 secondDerivative = glm::vec2(0.0f);
+    float curvature = 0.0f;
+};
+
+// Spécialisation 2D float de BezierCurve : controlPoints vient de la base, cette classe ajoute
+// les méthodes d'évaluation au choix, l'édition (fermeture, raccords) et les caches par version.
+// La base est privée : ses evaluate/evaluateMany/sampleUniform ignorent la transformation
+// différée, la méthode choisie et les caches, une conversion en BezierCurve2f& ne compile donc pas.
+class BezierCurveData : private BezierCurve<float, 2> {
 public:
-    std::vector<glm::vec2> controlPoints;
+    using BezierCurve<float, 2>::controlPoints;
+
+    // Pas maximal entre deux réamorçages de la table des différences avant.
+    static constexpr int kForwardDifferenceReseedInterval = 32;
+    // Degré jusqu'auquel les coefficients binomiaux sont tabulés à la compilation.
+    static constexpr int kMaxTabulatedDegree = 128;
 
     BezierCurveData() = default;
 
+    // Compteur incrémenté à chaque modification de la géométrie (points de contrôle ou
+    // transformation) ; les caches (base monomiale, polylignes, ...) sont reconstruits quand
+    // il change. Toute écriture directe dans controlPoints doit être suivie de markModified().
+    std::uint64_t version() const { return editVersion; }
+    void markModified() {
+        ++editVersion;
+        ++pointsVersion;
+    }
+    // Construit les caches paresseux utilisés par method, pour que plusieurs threads
+    // puissent ensuite évaluer la même courbe sans écrire dedans.
+    void prepareCaches(BezierMethod method) const;
+    void addControlPoint(const glm::vec2& point);
+
     glm::vec2 evaluate(float t, BezierMethod method = BezierMethod::DeCasteljau) const;
+    // Évalue la courbe pour count paramètres ts et écrit les points dans out (count éléments).
+    // Un seul tampon de travail est réutilisé pour tout le lot : aucune allocation par t.
+    void evaluateMany(const float* ts, std::size_t count, glm::vec2* out,
+                      BezierMethod method = BezierMethod::DeCasteljau) const;
+    void evaluateMany(const std::vector<float>& ts, std::vector<glm::vec2>& out,
+                      BezierMethod method = BezierMethod::DeCasteljau) const;
+    // Échantillonne t = i / segments pour i = 0..segments ; out doit contenir segments + 1 éléments.
+    //
+    // Avec ForwardDifference, chaque point coûte O(degré) additions en double. La dérive après
+    // m pas est bornée par eps_double * Σ_k C(m, k) * (m * |Δ^k| + 2^k * M), M étant la plus
+    // grande coordonnée des points de contrôle ; la table est réamorcée (au plus tous les
+    // kForwardDifferenceReseedInterval pas) dès que cette borne dépasserait eps_float * M.
+    // Chaque amorçage coûte O(degré³) : la méthode est intéressante jusqu'au degré ~10.
+    void sampleUniform(int segments, glm::vec2* out, BezierMethod method = BezierMethod::DeCasteljau) const;
+    // Aplatissement adaptatif : subdivise (De Casteljau en t = 0.5) tant qu'un morceau s'écarte
+    // de sa corde de plus de tolerance, puis émet les extrémités des morceaux retenus.
+    // Les parties presque droites ne coûtent qu'un segment. Remplace le contenu de out.
+    void flatten(float tolerance, std::vector<glm::vec2>& out, int maxDepth = 16) const;
+    // Position, dérivées et courbure pour count paramètres en une seule réduction de De Casteljau :
+    // les trois derniers niveaux du triangle donnent B, B' et B''.
+    void evaluateDifferentials(const float* ts, std::size_t count, CurveDifferential* out) const;
+    // Hodographe d'ordre 1 ou 2 (points de contrôle de B' ou B''), mis en cache par version.
+    // Il est exprimé dans le repère de controlPoints, sans la transformation différée.
+    const std::vector<glm::dvec2>& hodograph(int order) const;
+    glm::vec2 derivative(float t, int order = 1) const;
+
+    // Abscisse curviligne : table construite une fois par modification (Gauss–Legendre à 5 points
+    // sur des tranches de t), puis inversée sur une grille régulière en s pour un accès s -> t en O(1).
+    float length() const;
+    float parameterAtLength(float s) const;
+    // Comme sampleUniform, mais les points sont également espacés en longueur et non en t.
+    void sampleArcLength(int segments, glm::vec2* out, BezierMethod method = BezierMethod::DeCasteljau) const;
+    // Polyligne selon options (vide si moins de 2 points de contrôle).
+    void sample(const SamplingOptions& options, std::vector<glm::vec2>& out) const;
+    // Même polyligne, conservée d'une image à l'autre : elle n'est recalculée que si la version
+    // de la courbe ou les options (mode, méthode, nombre d'échantillons, tolérance) changent.
+    const std::vector<glm::vec2>& sampled(const SamplingOptions& options) const;
+    bool hasSampled(const SamplingOptions& options) const;
+    static SampleCacheStats sampleCacheStats();
+    static void resetSampleCacheStats();
+
+    // Transformation différée : applyTransformation compose la matrice (partie affine) sans
+    // réécrire les points ; elle est appliquée en sortie des noyaux d'évaluation et
+    // d'échantillonnage. controlPoints reste dans le repère local, worldControlPoints() donne
+    // le polygone transformé. Les éditions (ajout de point, fermeture, raccords) appellent bake().
     void applyTransformation(const glm::mat3& matrix);
+    // Applique la transformation aux points de contrôle et revient à l'identité ; la courbe
+    // ne change pas, les polylignes en cache restent valides.
+    void bake();
+    bool hasTransformation() const { return transformed; }
+    const glm::mat3& transformation() const { return transform; }
+    // Points de contrôle transformés, mis en cache par version (controlPoints lui-même sans transformation).
+    const std::vector<glm::vec2>& worldControlPoints() const;
+
     void duplicateLastPoint();
     bool isClosed(float epsilon = 0.01f) const;
     void closeCurveC0();
@@ -24,8 +134,38 @@ public:
     void connectC1(BezierCurveData& next);
     void connectC2(BezierCurveData& next);
 
+    // C(n, k) en double : table de Pascal jusqu'à kMaxTabulatedDegree, produit au-delà.
+    static double binomialCoefficient(int n, int k);
+
 private:
     glm::vec2 deCasteljau(float t) const;
     glm::vec2 evaluateDirect(float t) const;
-    int binomialCoefficient(int n, int k) const;
+    void evaluateSimd(const float* ts, std::size_t count, glm::vec2* out) const;
+    void sampleForwardDifference(int segments, glm::vec2* out) const;
+    void seedDifferenceTable(double t0, double h, glm::dvec2* table) const;
+    glm::vec2 evaluateHorner(float t) const;
+    const std::vector<glm::dvec2>& monomialCoefficients() const;
+    void updateArcLengthTable() const;
+
+    glm::vec2 evaluateLocal(float t, BezierMethod method) const;
+    void toWorld(glm::vec2* points, std::size_t count) const;
+
+    std::uint64_t editVersion = 0;
+    std::uint64_t pointsVersion = 0;  // points de contrôle seuls : clé des caches en repère local
+    glm::mat3 transform = glm::mat3(1.0f);
+    bool transformed = false;
+
+    // Cache paresseux : non thread-safe lors de la première évaluation après une modification.
+    mutable std::vector<glm::dvec2> monomial;
+    mutable std::uint64_t monomialVersion = ~std::uint64_t(0);
+    mutable std::vector<glm::dvec2> hodographs[2];
+    mutable std::uint64_t hodographVersion = ~std::uint64_t(0);
+    mutable std::vector<glm::vec2> cachedSamples;
+    mutable SamplingOptions cachedSampling;
+    mutable std::uint64_t cachedSamplesVersion = ~std::uint64_t(0);
+    mutable std::vector<float> arcLengthTable;   // longueur cumulée aux bornes des tranches de t
+    mutable std::vector<float> arcLengthInverse; // t pour s = k * length() / (taille - 1)
+    mutable std::uint64_t arcLengthVersion = ~std::uint64_t(0);  // longueur mesurée après transformation
+    mutable std::vector<glm::vec2> worldPoints;
+    mutable std::uint64_t worldPointsVersion = ~std::uint64_t(0);
 };
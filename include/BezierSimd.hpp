@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <glm/glm.hpp>
+
+enum class SimdLevel {
+    Scalar,
+    SSE,   // 4 paramètres par instruction
+    AVX2   // 8 paramètres par instruction
+};
+
+// Écart maximal avec BezierMethod::DeCasteljau, relatif à l'étendue des points de contrôle.
+// Les deux chemins font les mêmes opérations dans le même ordre (sans FMA), l'écart
+// observé est donc nul ; la marge couvre un compilateur qui contracterait en FMA.
+constexpr float kSimdBezierTolerance = 1e-5f;
+
+// Jeu d'instructions choisi à l'exécution (détecté une seule fois).
+SimdLevel detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
+
+// De Casteljau vectorisé sur plusieurs paramètres à la fois.
+// xs/ys : coordonnées des n points de contrôle en structure de tableaux.
+// Écrit B(ts[k]) dans out[k] pour k < count.
+void evaluateBezierSoA(const float* xs, const float* ys, std::size_t n,
+                       const float* ts, std::size_t count, glm::vec2* out);
+
+// Partie affine de m appliquée à un point (la dernière ligne est ignorée, comme dans
+// BezierCurveData::applyTransformation) : x' = m00 x + m10 y + m20, y' = m01 x + m11 y + m21.
+inline glm::vec2 transformPoint(const glm::mat3& m, const glm::vec2& p) {
+    return glm::vec2(m[0][0] * p.x + m[1][0] * p.y + m[2][0], m[0][1] * p.x + m[1][1] * p.y + m[2][1]);
+}
+
+// transformPoint sur count points, 2 (SSE) ou 4 (AVX2) à la fois, avec les mêmes opérations :
+// résultat identique au chemin scalaire. in et out peuvent être le même tableau.
+void transformPoints(const glm::mat3& m, const glm::vec2* in, glm::vec2* out, std::size_t count);
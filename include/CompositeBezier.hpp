@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "BezierCurveData.hpp"
+
+// Chaîne de segments cubiques : chaque segment a 4 points de contrôle et son premier point
+// coïncide avec le dernier du précédent. Évaluer, échantillonner ou modifier un point ne touche
+// qu'un ou deux segments, quel que soit le nombre total de points.
+class CompositeBezier {
+public:
+    std::vector<BezierCurveData> segments;
+
+    std::size_t segmentCount() const { return segments.size(); }
+
+    // Points de contrôle numérotés globalement : le point 3i est la jonction entre les segments i - 1 et i.
+    std::size_t pointCount() const { return segments.empty() ? 0 : 3 * segments.size() + 1; }
+    glm::vec2 point(std::size_t index) const;
+    void setPoint(std::size_t index, const glm::vec2& p);
+
+    // Ajoute un segment qui part du dernier point (ou de p0 si la chaîne est vide).
+    void appendSegment(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3);
+    void appendSegment(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3);
+
+    // Réimpose la continuité C0, C1 ou C2 à toutes les jonctions (connectC0/C1/C2 de BezierCurveData).
+    void enforceContinuity(int order);
+
+    // u dans [0, segmentCount()] : la partie entière choisit le segment, la partie fractionnaire est le t local.
+    glm::vec2 evaluate(float u) const;
+    // Uniform : options.segments intervalles répartis à parts égales entre les segments ; ArcLength :
+    // au prorata de la longueur de chaque segment, puis espacés en longueur dans le segment ;
+    // Adaptive : aplatissement par segment. options.method est transmise à chaque segment.
+    void sample(const SamplingOptions& options, std::vector<glm::vec2>& out) const;
+
+    // Convertit une courbe de haut degré : subdivision récursive de [0, 1] jusqu'à ce que l'interpolation
+    // cubique de Hermite (positions et dérivées exactes aux extrémités) reste à moins de tolerance.
+    // Les jonctions sont G1 par construction, comme après connectC1.
+    static CompositeBezier fromCurve(const BezierCurveData& curve, float tolerance, int maxDepth = 12);
+
+    // Ajuste une polyligne dense (trait numérisé) par moindres carrés, à la Schneider : chaîne de
+    // cubiques aussi courte que possible passant à moins de tolerance de chaque point d'entrée.
+    // Les jonctions partagent leur tangente, avec la sémantique de connectC1. Chaque niveau de
+    // découpage est linéaire en nombre de points ; les premiers découpages sont ramenés vers le
+    // milieu des grandes plages pour que la profondeur reste logarithmique.
+    static CompositeBezier fit(const glm::vec2* points, std::size_t count, float tolerance);
+    static CompositeBezier fit(const std::vector<glm::vec2>& points, float tolerance);
+};
@@ -6,15 +6,154 @@
 #define EXTRUSION_H
 #define GLM_ENABLE_EXPERIMENTAL
 
-#pragma once
-#pragma once
-
 #include <vector>
 #include "../external/glm/glm/glm.hpp"
 #include "Mesh.hpp"
+#include "MeshBuilder.hpp"
+#include "SweepFrames.hpp"
+#include "BezierCurveData.hpp"
+#include "BSplineCurve.hpp"
+
+// Les points du profil (linéaire) et les anneaux (révolution, balayage) sont répartis entre les
+// threads du pool ; le maillage est identique au bit près quel que soit le nombre de threads.
+Mesh extrudeLinear(const std::vector<glm::vec2>& profile, float height, float scaleTop,
+                   ThreadPool& pool = ThreadPool::shared());
+Mesh extrudeRevolution(const std::vector<glm::vec2>& profile, int steps, ThreadPool& pool = ThreadPool::shared());
+Mesh extrudeGeneralized(const std::vector<glm::vec2>& profile2D, const std::vector<glm::vec3>& path3D,
+                        ThreadPool& pool = ThreadPool::shared());
+
+// Variantes qui échantillonnent elles-mêmes le profil (uniforme ou adaptatif)
+Mesh extrudeLinear(const BezierCurveData& profile, const SamplingOptions& sampling, float height, float scaleTop);
+Mesh extrudeRevolution(const BezierCurveData& profile, const SamplingOptions& sampling, int steps);
+Mesh extrudeGeneralized(const BezierCurveData& profile, const SamplingOptions& sampling, const std::vector<glm::vec3>& path3D);
+
+// Profil B-spline : la polyligne en cache n'est recalculée que sur les intervalles modifiés
+Mesh extrudeLinear(const BSplineCurve& profile, const SamplingOptions& sampling, float height, float scaleTop);
+Mesh extrudeRevolution(const BSplineCurve& profile, const SamplingOptions& sampling, int steps);
+Mesh extrudeGeneralized(const BSplineCurve& profile, const SamplingOptions& sampling, const std::vector<glm::vec3>& path3D);
+
+// Nombres exacts de sommets et d'indices de chaque extrusion, connus avant d'écrire quoi que ce
+// soit (zéro quand le profil ou le chemin est trop court)
+struct MeshCounts {
+    std::size_t vertices = 0;
+    std::size_t indices = 0;       // en triangles séparés
+    std::size_t stripIndices = 0;  // en bandes avec marqueurs de redémarrage (grilles)
+};
+MeshCounts linearCounts(std::size_t profileSize);
+MeshCounts revolutionCounts(std::size_t profileSize, int slices);
+MeshCounts generalizedCounts(std::size_t profileSize, std::size_t pathSize);
+
+// Mêmes extrusions, écrites directement dans un tampon entrelacé aligné (MeshBuilder). Les
+// sommets sont identiques à ceux des extrude* ; révolution et balayage, qui sont des grilles,
+// sont émis en bandes (mêmes triangles, même enroulement), avec des indices 16 bits dès que les
+// sommets tiennent. Les UV suivent l'abscisse curviligne du profil (u) et l'avancée de
+// l'extrusion (v) ; les couvercles sont projetés sur leur boîte englobante.
+InterleavedMesh buildLinear(const std::vector<glm::vec2>& profile, float height, float scaleTop,
+                            VertexFormat format = VertexFormat::PositionNormal,
+                            ThreadPool& pool = ThreadPool::shared());
+InterleavedMesh buildRevolution(const std::vector<glm::vec2>& profile, int slices,
+                                VertexFormat format = VertexFormat::PositionNormal,
+                                ThreadPool& pool = ThreadPool::shared());
+InterleavedMesh buildGeneralized(const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path,
+                                 VertexFormat format = VertexFormat::PositionNormal,
+                                 ThreadPool& pool = ThreadPool::shared());
+
+// Données qui ne dépendent que du profil, gardées par les extrusions paramétrées
+struct LinearProfile {
+    std::vector<glm::vec2> points;
+    std::vector<glm::vec2> tangents;
+    float orientation = 1.0f;            // sens du polygone : enroulement des faces
+    std::vector<float> u;                // abscisse curviligne, vide sans UV
+    glm::vec2 capLow{0.0f}, capExtent{1.0f};  // boîte englobante des couvercles
+};
+
+struct RevolutionProfile {
+    std::vector<glm::vec2> points;
+    std::vector<float> radius, normalRadius;  // composantes tournées avec chaque anneau
+    std::vector<glm::vec2> planeNormals;      // normales dans le demi-plan (r, z)
+    std::vector<float> u;
+};
+
+// Extrusion linéaire paramétrée : le maillage est gardé, et un changement de hauteur ou
+// d'échelle ne réécrit que l'anneau du haut, son couvercle et les normales de la base ;
+// couvercle du bas, UV et indices ne bougent pas. Un nouveau profil reconstruit tout.
+class LinearExtrusion {
+public:
+    explicit LinearExtrusion(VertexFormat format = VertexFormat::PositionNormal) : vertexFormat(format) {}
+
+    const InterleavedMesh& update(const std::vector<glm::vec2>& profile, float height, float scaleTop,
+                                  ThreadPool& pool = ThreadPool::shared());
+    // Même profil que l'appel précédent, sans le comparer
+    const InterleavedMesh& update(float height, float scaleTop, ThreadPool& pool = ThreadPool::shared());
+
+    const InterleavedMesh& mesh() const { return result; }
+    void setFormat(VertexFormat format) { vertexFormat = format; }
+    std::size_t lastRewrittenVertices() const { return rewritten; }
+
+private:
+    void rebuild(float height, float scaleTop, ThreadPool& pool);
+
+    VertexFormat vertexFormat;
+    LinearProfile data;
+    float builtHeight = 0.0f, builtScale = 0.0f;
+    InterleavedMesh result;
+    std::size_t rewritten = 0;
+};
+
+// Révolution paramétrée : changer le nombre de tranches déplace tous les anneaux, mais tangentes,
+// normales du profil et UV sont réutilisées, et le tampon garde sa mémoire.
+class RevolutionExtrusion {
+public:
+    explicit RevolutionExtrusion(VertexFormat format = VertexFormat::PositionNormal) : vertexFormat(format) {}
+
+    const InterleavedMesh& update(const std::vector<glm::vec2>& profile, int slices,
+                                  ThreadPool& pool = ThreadPool::shared());
+    const InterleavedMesh& update(int slices, ThreadPool& pool = ThreadPool::shared());
+
+    const InterleavedMesh& mesh() const { return result; }
+    void setFormat(VertexFormat format) { vertexFormat = format; }
+    std::size_t lastRewrittenVertices() const { return rewritten; }
+
+private:
+    void rebuild(int slices, ThreadPool& pool);
+
+    VertexFormat vertexFormat;
+    RevolutionProfile data;
+    int builtSlices = 0;
+    InterleavedMesh result;
+    std::size_t rewritten = 0;
+};
+
+// Balayage généralisé conservé d'un appel à l'autre, avec ses repères (SweepFrames) et son
+// tampon entrelacé. Si seul le chemin change, seuls les anneaux dont le repère a bougé (et leurs
+// voisins, pour les normales) sont réécrits ; si seul le profil change, seules les colonnes des
+// points déplacés et de leurs voisins. Un changement de taille ou de format reconstruit tout.
+// Les normales, moyennes des faces (computeVertexNormals), sont recalculées sur toute la grille.
+class SweepExtrusion {
+public:
+    explicit SweepExtrusion(VertexFormat format = VertexFormat::PositionNormal) : vertexFormat(format) {}
+
+    const InterleavedMesh& update(const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path,
+                                  ThreadPool& pool = ThreadPool::shared());
+
+    const InterleavedMesh& mesh() const { return result; }
+    const SweepFrames& frames() const { return sweep; }
+    // Pris en compte au prochain update(), qui reconstruit alors tout le maillage
+    void setFormat(VertexFormat format) { vertexFormat = format; }
+    // Sommets recalculés lors du dernier update()
+    std::size_t lastRewrittenVertices() const { return rewritten; }
 
-Mesh extrudeLinear(const std::vector<glm::vec2>& profile, float height, float scaleTop);
-Mesh extrudeRevolution(const std::vector<glm::vec2>& profile, int steps);
-Mesh extrudeGeneralized(const std::vector<glm::vec2>& profile2D, const std::vector<glm::vec3>& path3D);
+private:
+    VertexFormat vertexFormat;
+    SweepFrames sweep;
+    std::vector<glm::vec2> sweptProfile;
+    std::vector<float> profileU;
+    std::size_t sweptPathSize = 0;
+    // Grille côté CPU pour computeVertexNormals : positions, triangles en liste, normales
+    std::vector<glm::vec3> positions, normals;
+    std::vector<unsigned int> triangles;
+    InterleavedMesh result;
+    std::size_t rewritten = 0;
+};
 
 #endif //EXTRUSION_H
@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "BezierCurveData.hpp"
+#include "ThreadPool.hpp"
+
+struct CurveIntersection {
+    int curveA = -1;
+    int curveB = -1;
+    float tA = 0.0f;
+    float tB = 0.0f;
+    glm::vec2 point = glm::vec2(0.0f);
+};
+
+struct IntersectionOptions {
+    float tolerance = 1e-5f;  // précision sur la position, en unités des points de contrôle
+    int maxDepth = 48;        // profondeur maximale de subdivision (somme des deux courbes)
+};
+
+// Intersections entre deux courbes : on subdivise en t = 0.5 la plus grande des deux tant que
+// les boîtes de leurs polygones de contrôle se chevauchent ; deux morceaux assez plats sont
+// intersectés comme des segments. Les paramètres sont rapportés à [0, 1] sur chaque courbe.
+// Les indices curveA / curveB du résultat valent indexA / indexB. Deux courbes qui se recouvrent
+// sur un intervalle ne donnent qu'un échantillonnage de points de leur partie commune.
+void intersectCurves(const BezierCurveData& a, const BezierCurveData& b, std::vector<CurveIntersection>& out,
+                     const IntersectionOptions& options = IntersectionOptions(), int indexA = 0, int indexB = 1);
+
+// Toutes les intersections entre courbes distinctes. Phase large : balayage sur x des boîtes
+// englobantes triées, seules les paires dont les boîtes se chevauchent passent en phase fine,
+// répartie sur le pool. Résultat trié par (curveA, curveB, tA), indépendant du nombre de threads.
+std::vector<CurveIntersection> intersectAll(const std::vector<BezierCurveData>& curves,
+                                            const IntersectionOptions& options = IntersectionOptions(),
+                                            ThreadPool& pool = ThreadPool::shared());
@@ -7,12 +7,38 @@
 #pragma once
 #include <vector>
 #include "../external/glm/glm/glm.hpp"
+#include "ThreadPool.hpp"
+
+// Poids d'une face dans la normale de ses sommets
+enum class NormalWeighting {
+    Uniform, // normale de face unitaire : chaque face compte pour 1
+    Area     // produit vectoriel brut : poids proportionnel à l'aire de la face
+};
+
+enum class NormalMethod {
+    Serial,   // dispersion face par face sur un seul thread (référence)
+    Parallel, // une plage fixe de faces par thread, accumulée dans son propre tampon, puis
+              // réduction par sommet : aucune atomique, aucune écriture partagée
+    Simd      // comme Parallel, normales de face calculées par paquets de 4 (SSE) ou 8 (AVX2)
+};
 
 struct Mesh {
     std::vector<glm::vec3> vertices;
     std::vector<glm::vec3> normals;
     std::vector<unsigned int> indices;
 
-    void computeNormals();
+    // Normales par sommet, moyenne des normales des faces adjacentes. Sur un seul thread, les
+    // trois méthodes donnent le même résultat au bit près ; en parallèle, les sommes partielles
+    // ne dépendent que du nombre de threads, pas de l'ordonnancement. Les faces dégénérées ne
+    // contribuent pas ; un sommet sans face valide garde une normale nulle.
+    void computeNormals(NormalWeighting weighting = NormalWeighting::Uniform,
+                        NormalMethod method = NormalMethod::Simd,
+                        ThreadPool& pool = ThreadPool::shared());
 };
+
+// Même calcul sur des tableaux qui ne forment pas un Mesh (indices : liste de triangles), pour
+// les extrusions qui écrivent ailleurs leurs sommets ; normals reçoit vertices.size() normales.
+void computeVertexNormals(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices,
+                          std::vector<glm::vec3>& normals, NormalWeighting weighting = NormalWeighting::Uniform,
+                          NormalMethod method = NormalMethod::Simd, ThreadPool& pool = ThreadPool::shared());
 #endif //MESH_H
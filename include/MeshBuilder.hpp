@@ -0,0 +1,140 @@
+#ifndef MESHBUILDER_H
+#define MESHBUILDER_H
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../external/glm/glm/glm.hpp"
+
+// Contenu d'un sommet dans le tampon entrelacé ; chaque sommet occupe un multiple de 16 octets
+enum class VertexFormat {
+    Position,           // x y z + 1 flottant de remplissage       : 16 octets
+    PositionNormal,     // x y z nx ny nz + 2 flottants de remplissage : 32 octets
+    PositionNormalUV    // x y z nx ny nz u v                      : 32 octets
+};
+
+// Bloc de 16 octets : en C++17, std::allocator respecte l'alignement étendu, donc le tampon
+// entier (et chaque sommet) est aligné sur 16 octets.
+struct alignas(16) VertexBlock {
+    float values[4];
+};
+
+// Largeur des indices : 16 bits dès que les sommets tiennent (0xFFFF reste réservé au marqueur
+// de redémarrage), 32 bits sinon
+enum class IndexType {
+    UInt16,
+    UInt32
+};
+
+enum class Primitive {
+    Triangles,     // 3 indices par triangle
+    TriangleStrip  // bandes séparées par restartIndex() (GL_PRIMITIVE_RESTART)
+};
+
+// Maillage prêt pour le GPU : un seul tampon de sommets entrelacés et un tampon d'indices
+// compact, tous deux alloués à leur taille exacte. data() et indexData() se passent tels quels
+// à glVertexPointer / glDrawElements ou glBufferData, sans recopie.
+struct InterleavedMesh {
+    VertexFormat format = VertexFormat::PositionNormal;
+    Primitive primitive = Primitive::Triangles;
+    IndexType indexType = IndexType::UInt32;
+    std::vector<VertexBlock> vertexData;
+    std::vector<std::uint16_t> indices16;  // un seul des deux tableaux est rempli, selon indexType
+    std::vector<std::uint32_t> indices32;
+
+    static IndexType indexTypeFor(std::size_t vertexCount) {
+        return vertexCount <= 0xFFFF ? IndexType::UInt16 : IndexType::UInt32;
+    }
+
+    static std::size_t blocksPerVertex(VertexFormat format) { return format == VertexFormat::Position ? 1 : 2; }
+    static bool hasNormals(VertexFormat format) { return format != VertexFormat::Position; }
+    static bool hasUV(VertexFormat format) { return format == VertexFormat::PositionNormalUV; }
+
+    std::size_t stride() const { return blocksPerVertex(format) * sizeof(VertexBlock); }
+    std::size_t vertexCount() const { return vertexData.size() / blocksPerVertex(format); }
+    std::size_t sizeInBytes() const { return vertexData.size() * sizeof(VertexBlock); }
+    bool empty() const { return vertexData.empty(); }
+
+    // Début du tampon ; position au décalage 0, normale à 3 flottants, UV à 6
+    const float* data() const { return vertexData.empty() ? nullptr : vertexData.front().values; }
+    static constexpr std::size_t normalOffset = 3;
+    static constexpr std::size_t uvOffset = 6;
+
+    std::size_t indexCount() const { return indexType == IndexType::UInt16 ? indices16.size() : indices32.size(); }
+    std::size_t indexSize() const { return indexType == IndexType::UInt16 ? 2 : 4; }
+    std::size_t indexBytes() const { return indexCount() * indexSize(); }
+    const void* indexData() const {
+        if (indexCount() == 0) return nullptr;
+        return indexType == IndexType::UInt16 ? static_cast<const void*>(indices16.data()) : indices32.data();
+    }
+    std::uint32_t index(std::size_t k) const { return indexType == IndexType::UInt16 ? indices16[k] : indices32[k]; }
+    std::uint32_t restartIndex() const { return indexType == IndexType::UInt16 ? 0xFFFFu : 0xFFFFFFFFu; }
+
+    // Liste de triangles équivalente (bandes dépliées, enroulement conservé), pour les
+    // traitements côté CPU
+    std::vector<std::uint32_t> triangleList() const;
+
+    glm::vec3 position(std::size_t i) const;
+    glm::vec3 normal(std::size_t i) const;  // nulle si le format n'a pas de normales
+    glm::vec2 uv(std::size_t i) const;      // nulle si le format n'a pas d'UV
+};
+
+// Remplit un InterleavedMesh dont les nombres de sommets et d'indices sont connus d'avance :
+// une allocation par tableau, aucune réallocation. La largeur des indices suit le nombre de
+// sommets. Les sommets sont écrits à leur indice, donc dans n'importe quel ordre ; les triangles
+// sont ajoutés à la suite ou placés par numéro, les bandes indice par indice.
+class MeshBuilder {
+public:
+    MeshBuilder(VertexFormat format, std::size_t vertexCount, std::size_t indexCount,
+                Primitive primitive = Primitive::Triangles);
+    // Reprend un maillage existant pour en réécrire une partie sur place, sans réallocation
+    explicit MeshBuilder(InterleavedMesh&& existing);
+    // Reprend la mémoire d'un maillage existant pour un maillage de tailles données ; le contenu
+    // est à réécrire entièrement
+    MeshBuilder(InterleavedMesh&& existing, VertexFormat format, std::size_t vertexCount, std::size_t indexCount,
+                Primitive primitive = Primitive::Triangles);
+
+    VertexFormat format() const { return mesh.format; }
+    bool wantsNormals() const { return InterleavedMesh::hasNormals(mesh.format); }
+    bool wantsUV() const { return InterleavedMesh::hasUV(mesh.format); }
+    bool wantsStrips() const { return mesh.primitive == Primitive::TriangleStrip; }
+
+    void vertex(std::size_t i, const glm::vec3& position, const glm::vec3& normal, const glm::vec2& uv) {
+        VertexBlock* out = &mesh.vertexData[i * blocks];
+        out[0].values[0] = position.x; out[0].values[1] = position.y; out[0].values[2] = position.z;
+        if (blocks == 1) { out[0].values[3] = 0.0f; return; }
+        out[0].values[3] = normal.x;
+        out[1].values[0] = normal.y; out[1].values[1] = normal.z;
+        out[1].values[2] = uv.x; out[1].values[3] = uv.y;  // uv nul pour PositionNormal
+    }
+
+    void triangle(unsigned int a, unsigned int b, unsigned int c) {
+        triangleAt(cursor / 3, a, b, c);
+        cursor += 3;
+    }
+
+    // Triangle numéro t, écrit à sa place : plusieurs threads peuvent remplir des triangles
+    // (et des sommets) distincts en même temps
+    void triangleAt(std::size_t t, unsigned int a, unsigned int b, unsigned int c) {
+        indexAt(3 * t, a);
+        indexAt(3 * t + 1, b);
+        indexAt(3 * t + 2, c);
+    }
+
+    // Indice k d'une bande ; restartAt(k) y place le marqueur de redémarrage
+    void indexAt(std::size_t k, unsigned int value) {
+        if (mesh.indexType == IndexType::UInt16) mesh.indices16[k] = static_cast<std::uint16_t>(value);
+        else mesh.indices32[k] = value;
+    }
+    void restartAt(std::size_t k) { indexAt(k, mesh.restartIndex()); }
+
+    // Rend le maillage ; le builder est vide ensuite
+    InterleavedMesh finish();
+
+private:
+    InterleavedMesh mesh;
+    std::size_t blocks;
+    std::size_t cursor = 0;
+};
+
+#endif //MESHBUILDER_H
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "BezierCurveData.hpp"
+#include "ThreadPool.hpp"
+
+// Polylignes de plusieurs courbes dans un seul tampon préalloué :
+// la courbe i occupe points[offsets[i]] .. points[offsets[i + 1] - 1].
+struct SampledCurves {
+    std::vector<glm::vec2> points;
+    std::vector<std::size_t> offsets;
+};
+
+// Échantillonne toutes les courbes à t = j / segments (aucun point sous 2 points de contrôle),
+// en répartissant le travail sur le pool. Les courbes courtes sont groupées, les longues découpées
+// en plages de paramètres ; chaque point est calculé exactement comme par sampleUniform, le
+// résultat est donc identique à l'ordre séquentiel quel que soit le nombre de threads.
+void sampleCurvesParallel(const std::vector<BezierCurveData>& curves, int segments, BezierMethod method,
+                          SampledCurves& out, ThreadPool& pool = ThreadPool::shared());
+
+// Remet à jour en parallèle les polylignes en cache (BezierCurveData::sampled) des courbes modifiées.
+void refreshSampleCaches(const std::vector<BezierCurveData>& curves, const SamplingOptions& options,
+                         ThreadPool& pool = ThreadPool::shared());
+
+// Fige la transformation différée de toutes les courbes (BezierCurveData::bake, transformPoints
+// vectorisé) en répartissant les courbes transformées sur le pool.
+void bakeTransforms(std::vector<BezierCurveData>& curves, ThreadPool& pool = ThreadPool::shared());
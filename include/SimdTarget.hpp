@@ -0,0 +1,15 @@
+#pragma once
+
+// Détection x86 et attribut de cible partagés par tous les noyaux SSE / AVX2 :
+// chaque fonction vectorielle est compilée pour son jeu d'instructions et n'est
+// appelée qu'après detectSimdLevel().
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BEZIER_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BEZIER_TARGET(isa)
+#else
+#define BEZIER_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
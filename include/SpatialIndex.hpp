@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "BezierCurveData.hpp"
+
+struct ControlPointRef {
+    int curve = -1;
+    int point = -1;
+};
+
+// Boîte englobante et enveloppe convexe (sens trigonométrique) des points de contrôle :
+// la courbe est contenue dans les deux, ce qui donne des minorants de distance.
+struct CurveBounds {
+    glm::vec2 min = glm::vec2(0.0f);
+    glm::vec2 max = glm::vec2(0.0f);
+    std::vector<glm::vec2> hull;
+};
+
+// Index 2D pour le picking : grille uniforme sur les points de contrôle et BVH sur les
+// boîtes des courbes. update() ne touche que les courbes dont la version a changé : leurs
+// points changent de cellule, leur boîte et leur enveloppe sont recalculées et le BVH est
+// réajusté sans changer de forme. Tout est reconstruit quand une courbe ou un point est
+// ajouté ou retiré, ou quand trop de points sont sortis de la grille.
+class CurveSpatialIndex {
+public:
+    void update(const std::vector<BezierCurveData>& curves);
+
+    // Point de contrôle le plus proche de p à moins de maxDistance ; false si aucun.
+    bool nearestControlPoint(const glm::vec2& p, float maxDistance, ControlPointRef& result) const;
+
+    // Courbe la plus proche de p (distance à sa polyligne en cache) à moins de maxDistance ;
+    // -1 si aucune. Les courbes sont écartées par boîte puis par enveloppe avant l'échantillonnage.
+    int nearestCurve(const std::vector<BezierCurveData>& curves, const SamplingOptions& sampling,
+                     const glm::vec2& p, float maxDistance, float* distance = nullptr) const;
+
+    const CurveBounds& bounds(int curve) const { return curveBounds[curve]; }
+    std::size_t pointCount() const { return entries.size(); }
+
+private:
+    // Les cellules sont des listes chaînées d'entrées : changer un point de cellule ne déplace
+    // rien d'autre. Les entrées sont rangées par courbe, entries[pointBase[c] + i] pour le point i.
+    struct GridEntry {
+        glm::vec2 position;
+        ControlPointRef ref;
+        int cell = 0;
+        int next = -1;         // entrée suivante de la même cellule, -1 en fin de liste
+        bool outside = false;  // hors de la grille, rangée dans la cellule du bord la plus proche
+    };
+
+    struct BvhNode {
+        glm::vec2 min, max;
+        int left = -1, right = -1;  // enfants, -1 pour une feuille
+        int first = 0, count = 0;   // plage dans curveOrder pour une feuille
+    };
+
+    void rebuild(const std::vector<BezierCurveData>& curves);
+    void updateCurve(const std::vector<BezierCurveData>& curves, std::size_t c);
+    void buildGrid();
+    int buildBvh(int first, int count);
+    void refitBvh();
+    int cellIndex(int cx, int cy) const { return cy * gridWidth + cx; }
+    int cellOf(const glm::vec2& p, bool& outside) const;
+    void link(int entry);
+    void unlink(int entry);
+
+    std::vector<std::uint64_t> versions;
+    std::vector<CurveBounds> curveBounds;
+
+    glm::vec2 gridOrigin = glm::vec2(0.0f);
+    float cellSize = 1.0f;
+    int gridWidth = 0, gridHeight = 0;
+    std::vector<int> cellHead;   // première entrée de chaque cellule, -1 si vide
+    std::vector<int> pointBase;  // entrées de la courbe c : [pointBase[c], pointBase[c + 1])
+    std::vector<GridEntry> entries;
+    std::size_t outsideCount = 0;
+
+    std::vector<BvhNode> nodes;
+    std::vector<int> curveOrder;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Repères le long d'un chemin 3D pour le balayage généralisé : repères à rotation minimale
+// (double réflexion, Wang et al. 2008), sans le basculement du vecteur « up » quand la tangente
+// s'approche de l'axe y. Les repères sont gardés d'un appel à l'autre ; update() ne recalcule
+// qu'à partir du premier point modifié et s'arrête dès qu'un repère retombe sur l'ancien.
+class SweepFrames {
+public:
+    // Compare le chemin au précédent et met les repères à jour. Renvoie true si un repère ou
+    // un point a changé ; [changedBegin(), changedEnd()) couvre alors tous les indices touchés.
+    bool update(const std::vector<glm::vec3>& path);
+
+    const std::vector<glm::vec3>& path() const { return points; }
+    // Colonnes : côté, normale, tangente (repère direct, comme l'ancien repère « up »)
+    const std::vector<glm::mat3>& frames() const { return pathFrames; }
+    std::size_t size() const { return points.size(); }
+    std::uint64_t version() const { return frameVersion; }
+
+    std::size_t changedBegin() const { return firstChanged; }
+    std::size_t changedEnd() const { return lastChanged; }
+
+private:
+    glm::vec3 tangentAt(std::size_t i) const;
+    glm::mat3 initialFrame() const;
+
+    std::vector<glm::vec3> points;
+    std::vector<glm::vec3> tangents;
+    std::vector<glm::mat3> pathFrames;
+    std::uint64_t frameVersion = 0;
+    std::size_t firstChanged = 0, lastChanged = 0;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads à vol de tâches : parallelFor répartit les indices par blocs contigus
+// sur une file par thread ; un thread dont la file est vide vole l'autre extrémité d'une
+// autre file. Le thread appelant participe au travail.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Nombre de threads qui exécutent les tâches, appelant compris.
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+    // Exécute task(i) pour i < count et attend la fin. Non réentrant depuis une tâche.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    // Pool partagé par l'application, créé au premier appel.
+    static ThreadPool& shared();
+
+private:
+    // File [head, tasks.size()) : le propriétaire dépile à l'arrière, les voleurs avancent head.
+    // Un vecteur garde sa capacité d'un parallelFor à l'autre, là où une deque libère et
+    // réalloue ses blocs au fil des appels.
+    struct Queue {
+        std::mutex mutex;
+        std::vector<std::size_t> tasks;
+        std::size_t head = 0;
+    };
+
+    void workerLoop(unsigned self);
+    bool runOne(unsigned self);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues;  // la dernière file est celle de l'appelant
+
+    std::mutex submitMutex;  // un seul parallelFor à la fois
+    std::mutex stateMutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::atomic<const std::function<void(std::size_t)>*> job{nullptr};
+    std::atomic<std::size_t> remaining{0};
+    std::uint64_t generation = 0;
+    bool stopping = false;
+};
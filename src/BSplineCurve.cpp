@@ -0,0 +1,222 @@
+#include "BSplineCurve.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// La méthode d'évaluation n'intervient pas : de Boor est toujours utilisé
+bool sameSampling(const SamplingOptions& a, const SamplingOptions& b) {
+    if (a.mode != b.mode) return false;
+    if (a.mode == SamplingMode::Adaptive) return a.tolerance == b.tolerance;
+    return a.segments == b.segments;
+}
+
+float distanceToSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    const glm::vec2 ab = b - a;
+    const float len2 = glm::dot(ab, ab);
+    const float u = (len2 > 0.0f) ? glm::clamp(glm::dot(p - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+    return glm::length(p - (a + u * ab));
+}
+
+}
+
+BSplineCurve::BSplineCurve(int degree) : p(glm::clamp(degree, 1, kMaxDegree)) {}
+
+void BSplineCurve::setDegree(int degree) {
+    degree = glm::clamp(degree, 1, kMaxDegree);
+    if (degree == p) return;
+    p = degree;
+    uniformKnots = true;
+    rebuildUniformKnots();
+    invalidateAll();
+}
+
+void BSplineCurve::addControlPoint(const glm::vec2& point, float weight) {
+    controlPoints.push_back(point);
+    pointWeights.push_back(weight);
+    // Un vecteur explicite n'a plus la bonne taille : retour aux nœuds uniformes
+    uniformKnots = true;
+    rebuildUniformKnots();
+    invalidateAll();
+}
+
+void BSplineCurve::setControlPoint(std::size_t index, const glm::vec2& point) {
+    if (index >= controlPoints.size() || controlPoints[index] == point) return;
+    controlPoints[index] = point;
+    invalidateAround(index);
+}
+
+void BSplineCurve::setWeight(std::size_t index, float weight) {
+    if (index >= pointWeights.size() || pointWeights[index] == weight) return;
+    pointWeights[index] = weight;
+    invalidateAround(index);
+}
+
+bool BSplineCurve::setKnots(const std::vector<float>& knots) {
+    if (knots.size() != controlPoints.size() + p + 1) return false;
+    if (!std::is_sorted(knots.begin(), knots.end())) return false;
+    if (!(knots[p] < knots[controlPoints.size()])) return false;  // domaine vide
+    knotVector = knots;
+    uniformKnots = false;
+    invalidateAll();
+    return true;
+}
+
+void BSplineCurve::clear() {
+    controlPoints.clear();
+    pointWeights.clear();
+    knotVector.clear();
+    uniformKnots = true;
+    invalidateAll();
+}
+
+void BSplineCurve::rebuildUniformKnots() {
+    if (!uniformKnots) return;
+    const std::size_t n = controlPoints.size();
+    knotVector.clear();
+    if (n <= static_cast<std::size_t>(p)) return;
+
+    // p + 1 nœuds répétés à chaque bout, intérieurs régulièrement espacés dans [0, 1]
+    const std::size_t interior = n - p - 1;
+    knotVector.assign(p + 1, 0.0f);
+    for (std::size_t i = 1; i <= interior; ++i)
+        knotVector.push_back(static_cast<float>(i) / static_cast<float>(interior + 1));
+    knotVector.insert(knotVector.end(), p + 1, 1.0f);
+}
+
+void BSplineCurve::invalidateAll() {
+    ++editVersion;
+    samplesValid = false;
+    spanSamples.clear();
+    spanDirty.clear();
+}
+
+void BSplineCurve::invalidateAround(std::size_t index) {
+    ++editVersion;
+    samplesValid = false;
+    // Le point i n'influence que les intervalles k = i .. i + p, soit les blocs k - p
+    const std::size_t first = (index > static_cast<std::size_t>(p)) ? index - p : 0;
+    const std::size_t last = std::min(index, spanDirty.empty() ? 0 : spanDirty.size() - 1);
+    for (std::size_t k = first; k <= last && k < spanDirty.size(); ++k) spanDirty[k] = 1;
+}
+
+std::size_t BSplineCurve::findSpan(float x) const {
+    const std::size_t n = controlPoints.size();
+    // Dernier k dans [p, n - 1] tel que knots[k] <= x : les intervalles vides sont sautés
+    const auto first = knotVector.begin() + p + 1, last = knotVector.begin() + n;
+    const std::size_t k = static_cast<std::size_t>(std::upper_bound(first, last, x) - knotVector.begin()) - 1;
+    return std::min(k, n - 1);
+}
+
+glm::vec2 BSplineCurve::deBoor(std::size_t span, float x) const {
+    // Coordonnées homogènes (w x, w y, w) pour traiter le cas rationnel avec la même récurrence
+    glm::vec3 d[kMaxDegree + 1];
+    for (int j = 0; j <= p; ++j) {
+        const std::size_t i = span - p + j;
+        d[j] = glm::vec3(controlPoints[i] * pointWeights[i], pointWeights[i]);
+    }
+    for (int r = 1; r <= p; ++r) {
+        for (int j = p; j >= r; --j) {
+            const float left = knotVector[span - p + j];
+            const float right = knotVector[span + 1 + j - r];
+            const float alpha = (right > left) ? (x - left) / (right - left) : 0.0f;
+            d[j] = (1.0f - alpha) * d[j - 1] + alpha * d[j];
+        }
+    }
+    return glm::vec2(d[p]) / d[p].z;
+}
+
+glm::vec2 BSplineCurve::evaluate(float u) const {
+    if (!valid()) return controlPoints.empty() ? glm::vec2(0.0f) : controlPoints.front();
+    const float lo = knotVector[p], hi = knotVector[controlPoints.size()];
+    const float x = lo + glm::clamp(u, 0.0f, 1.0f) * (hi - lo);
+    return deBoor(findSpan(x), x);
+}
+
+void BSplineCurve::sampleSpan(std::size_t span, const SamplingOptions& options, std::vector<glm::vec2>& out) const {
+    // Le bloc contient le début de l'intervalle mais pas sa fin, qui commence le bloc suivant
+    out.clear();
+    const float x0 = knotVector[span], x1 = knotVector[span + 1];
+    if (!(x1 > x0)) return;
+
+    if (options.mode != SamplingMode::Adaptive) {
+        const std::size_t n = controlPoints.size();
+        const float domain = knotVector[n] - knotVector[p];
+        const int segments = std::max(1, static_cast<int>(std::lround(std::max(options.segments, 1) * (x1 - x0) / domain)));
+        out.reserve(segments);
+        for (int i = 0; i < segments; ++i)
+            out.push_back(deBoor(span, x0 + (x1 - x0) * static_cast<float>(i) / segments));
+        return;
+    }
+
+    // Aplatissement : on coupe [a, b] tant que les points en 1/4, 1/2 et 3/4 s'écartent de la corde
+    constexpr int kMaxDepth = 16;
+    struct Piece {
+        float a, b;
+        glm::vec2 pa, pb;
+        int depth;
+    };
+    thread_local std::vector<Piece> stack;
+    stack.assign(1, Piece{x0, x1, deBoor(span, x0), deBoor(span, x1), 0});
+    while (!stack.empty()) {
+        const Piece piece = stack.back();
+        stack.pop_back();
+        const float mid = 0.5f * (piece.a + piece.b);
+        const glm::vec2 pm = deBoor(span, mid);
+        bool flat = piece.depth >= kMaxDepth;
+        if (!flat) {
+            const glm::vec2 q1 = deBoor(span, 0.5f * (piece.a + mid));
+            const glm::vec2 q3 = deBoor(span, 0.5f * (mid + piece.b));
+            flat = distanceToSegment(pm, piece.pa, piece.pb) <= options.tolerance &&
+                   distanceToSegment(q1, piece.pa, piece.pb) <= options.tolerance &&
+                   distanceToSegment(q3, piece.pa, piece.pb) <= options.tolerance;
+        }
+        if (flat) {
+            out.push_back(piece.pa);
+            continue;
+        }
+        stack.push_back(Piece{mid, piece.b, pm, piece.pb, piece.depth + 1});
+        stack.push_back(Piece{piece.a, mid, piece.pa, pm, piece.depth + 1});
+    }
+}
+
+void BSplineCurve::sample(const SamplingOptions& options, std::vector<glm::vec2>& out) const {
+    out.clear();
+    if (!valid()) return;
+    std::vector<glm::vec2> block;
+    for (std::size_t span = p; span < controlPoints.size(); ++span) {
+        sampleSpan(span, options, block);
+        out.insert(out.end(), block.begin(), block.end());
+    }
+    out.push_back(evaluate(1.0f));
+}
+
+const std::vector<glm::vec2>& BSplineCurve::sampled(const SamplingOptions& options) const {
+    resampledSpans = 0;
+    if (!valid()) {
+        cachedSamples.clear();
+        return cachedSamples;
+    }
+
+    const std::size_t spans = controlPoints.size() - p;
+    if (spanSamples.size() != spans || !sameSampling(cachedSampling, options)) {
+        spanSamples.assign(spans, std::vector<glm::vec2>());
+        spanDirty.assign(spans, 1);
+        cachedSampling = options;
+        samplesValid = false;
+    }
+    if (samplesValid) return cachedSamples;
+
+    for (std::size_t k = 0; k < spans; ++k) {
+        if (!spanDirty[k]) continue;
+        sampleSpan(k + p, options, spanSamples[k]);
+        spanDirty[k] = 0;
+        ++resampledSpans;
+    }
+
+    cachedSamples.clear();
+    for (const auto& block : spanSamples) cachedSamples.insert(cachedSamples.end(), block.begin(), block.end());
+    cachedSamples.push_back(evaluate(1.0f));
+    samplesValid = true;
+    return cachedSamples;
+}
@@ -0,0 +1,108 @@
+#include "BezierCurveData.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Gauss–Legendre à 5 points sur [-1, 1]
+constexpr double kGaussNodes[5] = {
+    0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640
+};
+constexpr double kGaussWeights[5] = {
+    0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891
+};
+
+// Nombre de tranches de t : plus de tranches pour les degrés élevés, plafonné pour borner le coût.
+int arcLengthSlices(std::size_t pointCount) {
+    return static_cast<int>(std::clamp<std::size_t>(2 * pointCount, 32, 256));
+}
+
+// Taille de la table inverse s -> t
+int inverseSize(int slices) {
+    return 4 * slices + 1;
+}
+
+// |L B'(t)| par De Casteljau sur l'hodographe local, L étant la partie linéaire de la transformation
+double speedAt(const std::vector<glm::dvec2>& hodograph, const glm::dmat2& linear,
+               std::vector<glm::dvec2>& temp, double t) {
+    const std::size_t n = hodograph.size();
+    std::copy(hodograph.begin(), hodograph.end(), temp.begin());
+    for (std::size_t level = n - 1; level > 0; --level)
+        for (std::size_t i = 0; i < level; ++i)
+            temp[i] = (1 - t) * temp[i] + t * temp[i + 1];
+    return glm::length(linear * temp[0]);
+}
+
+}
+
+void BezierCurveData::updateArcLengthTable() const {
+    if (arcLengthVersion == editVersion) return;
+    arcLengthVersion = editVersion;
+
+    const std::size_t count = controlPoints.size();
+    if (count < 2) {
+        arcLengthTable.assign(2, 0.0f);
+        arcLengthInverse.assign({0.0f, 1.0f});
+        return;
+    }
+
+    const std::vector<glm::dvec2>& velocity = hodograph(1);
+    const glm::dmat2 linear = glm::dmat2(glm::mat2(transform));
+    thread_local std::vector<glm::dvec2> temp;
+    temp.resize(velocity.size());
+
+    // Longueur cumulée aux bornes de chaque tranche
+    const int slices = arcLengthSlices(count);
+    const double width = 1.0 / slices;
+    arcLengthTable.resize(slices + 1);
+    arcLengthTable[0] = 0.0f;
+    double total = 0.0;
+    for (int j = 0; j < slices; ++j) {
+        const double mid = (j + 0.5) * width;
+        double sum = 0.0;
+        for (int g = 0; g < 5; ++g)
+            sum += kGaussWeights[g] * speedAt(velocity, linear, temp, mid + 0.5 * width * kGaussNodes[g]);
+        total += 0.5 * width * sum;
+        arcLengthTable[j + 1] = static_cast<float>(total);
+    }
+
+    // Inversion sur une grille régulière en s ; la longueur est monotone, un seul parcours suffit
+    const int size = inverseSize(slices);
+    arcLengthInverse.resize(size);
+    int j = 0;
+    for (int k = 0; k < size; ++k) {
+        const float s = static_cast<float>(total * k / (size - 1));
+        while (j < slices - 1 && arcLengthTable[j + 1] < s) ++j;
+        const float span = arcLengthTable[j + 1] - arcLengthTable[j];
+        const float local = (span > 0.0f) ? glm::clamp((s - arcLengthTable[j]) / span, 0.0f, 1.0f) : 0.0f;
+        arcLengthInverse[k] = static_cast<float>((j + local) * width);
+    }
+    arcLengthInverse.back() = 1.0f;
+}
+
+float BezierCurveData::length() const {
+    updateArcLengthTable();
+    return arcLengthTable.back();
+}
+
+float BezierCurveData::parameterAtLength(float s) const {
+    updateArcLengthTable();
+    const float total = arcLengthTable.back();
+    if (total <= 0.0f) return 0.0f;
+
+    const float x = glm::clamp(s / total, 0.0f, 1.0f) * (arcLengthInverse.size() - 1);
+    const std::size_t k = std::min(static_cast<std::size_t>(x), arcLengthInverse.size() - 2);
+    const float f = x - k;
+    return arcLengthInverse[k] + f * (arcLengthInverse[k + 1] - arcLengthInverse[k]);
+}
+
+void BezierCurveData::sampleArcLength(int segments, glm::vec2* out, BezierMethod method) const {
+    if (segments < 1) segments = 1;
+    const float total = length();
+
+    thread_local std::vector<float> ts;
+    ts.resize(segments + 1);
+    for (int i = 0; i <= segments; ++i)
+        ts[i] = parameterAtLength(total * i / segments);
+    evaluateMany(ts.data(), ts.size(), out, method);
+}
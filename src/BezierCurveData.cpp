@@ -1,10 +1,330 @@
 #include "BezierCurveData.hpp"
+#include "BezierSimd.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
+
+namespace {
+
+std::atomic<std::size_t> sampleCacheHits{0};
+std::atomic<std::size_t> sampleCacheMisses{0};
+
+// Deux réglages produisent-ils la même polyligne ? Seuls les champs utilisés par le mode comptent.
+bool sameSampling(const SamplingOptions& a, const SamplingOptions& b) {
+    if (a.mode != b.mode) return false;
+    if (a.mode == SamplingMode::Adaptive) return a.tolerance == b.tolerance;
+    return a.method == b.method && a.segments == b.segments;
+}
+
+// Tampon de travail propre à chaque thread : il ne grandit que lorsque le degré augmente.
+glm::vec2* scratchBuffer(std::size_t size) {
+    thread_local std::vector<glm::vec2> buffer;
+    if (buffer.size() < size) buffer.resize(size);
+    return buffer.data();
+}
+
+glm::vec2 reduceInPlace(glm::vec2* pts, std::size_t n, float t) {
+    return BezierCurve2f::deCasteljauInPlace(pts, n, t);
+}
+
+// Triangle de Pascal en double calculé à la compilation : C(n, k) = values[n(n+1)/2 + k].
+// Les additions sont exactes jusqu'à 2^53 puis l'erreur relative reste de l'ordre de n * eps.
+struct BinomialTable {
+    double values[(BezierCurveData::kMaxTabulatedDegree + 1) * (BezierCurveData::kMaxTabulatedDegree + 2) / 2] = {};
+
+    static constexpr int rowStart(int n) { return n * (n + 1) / 2; }
+
+    constexpr BinomialTable() {
+        for (int n = 0; n <= BezierCurveData::kMaxTabulatedDegree; ++n) {
+            values[rowStart(n)] = 1.0;
+            values[rowStart(n) + n] = 1.0;
+            for (int k = 1; k < n; ++k)
+                values[rowStart(n) + k] = values[rowStart(n - 1) + k - 1] + values[rowStart(n - 1) + k];
+        }
+    }
+};
+
+constexpr BinomialTable kBinomials;
+
+static_assert(kBinomials.values[BinomialTable::rowStart(4) + 2] == 6.0, "triangle de Pascal");
+static_assert(kBinomials.values[BinomialTable::rowStart(40) + 20] == 137846528820.0, "C(40, 20)");
+
+float distanceToSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    const glm::vec2 ab = b - a;
+    const float len2 = glm::dot(ab, ab);
+    const float u = (len2 > 0.0f) ? glm::clamp(glm::dot(p - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+    return glm::distance(p, a + u * ab);
+}
+
+// Un morceau est plat si tout son polygone de contrôle (donc la courbe, par la propriété
+// d'enveloppe convexe) reste à moins de tolerance de la corde.
+bool isFlat(const glm::vec2* pts, std::size_t n, float tolerance) {
+    for (std::size_t i = 1; i + 1 < n; ++i)
+        if (distanceToSegment(pts[i], pts[0], pts[n - 1]) > tolerance) return false;
+    return true;
+}
+
+// Coupe pts en t = 0.5 ; left et right reçoivent chacun n points.
+void splitHalf(const glm::vec2* pts, std::size_t n, glm::vec2* left, glm::vec2* right, glm::vec2* temp) {
+    std::copy(pts, pts + n, temp);
+    for (std::size_t level = 0; level < n; ++level) {
+        left[level] = temp[0];
+        right[n - 1 - level] = temp[n - 1 - level];
+        for (std::size_t i = 0; i + 1 < n - level; ++i)
+            temp[i] = 0.5f * (temp[i] + temp[i + 1]);
+    }
+}
+
+// Borne de dérive des différences avant après m pas (voir sampleUniform) :
+// l'arrondi de chaque addition et l'erreur d'amorçage de Δ^k se propagent
+// vers Δ^0 avec un facteur C(m, k).
+double forwardDifferenceDrift(const glm::dvec2* table, std::size_t n, int m, double extent) {
+    const double eps = std::numeric_limits<double>::epsilon();
+    double bound = 0.0;
+    double binom = 1.0;
+    double seedError = extent;
+    for (std::size_t k = 0; k < n; ++k) {
+        const double magnitude = std::max(std::abs(table[k].x), std::abs(table[k].y));
+        bound += binom * (m * magnitude + seedError);
+        binom = binom * (m - static_cast<double>(k)) / static_cast<double>(k + 1);
+        if (binom <= 0.0) break;
+        seedError *= 2.0;
+    }
+    return eps * bound;
+}
+
+}
 
 glm::vec2 BezierCurveData::evaluate(float t, BezierMethod method) const {
-    return (method == BezierMethod::DeCasteljau) ?
-        deCasteljau(t) :
-        evaluateDirect(t);
+    const glm::vec2 p = evaluateLocal(t, method);
+    return transformed ? transformPoint(transform, p) : p;
+}
+
+glm::vec2 BezierCurveData::evaluateLocal(float t, BezierMethod method) const {
+    switch (method) {
+        case BezierMethod::DirectFormula: return evaluateDirect(t);
+        case BezierMethod::Simd: {
+            glm::vec2 p;
+            evaluateSimd(&t, 1, &p);
+            return p;
+        }
+        case BezierMethod::Horner: return evaluateHorner(t);
+        default: return deCasteljau(t);
+    }
+}
+
+void BezierCurveData::evaluateMany(const float* ts, std::size_t count, glm::vec2* out,
+                                   BezierMethod method) const {
+    if (controlPoints.empty()) {
+        std::fill(out, out + count, glm::vec2(0.0f));
+        return;
+    }
+
+    // Tous les noyaux travaillent en repère local ; la transformation est appliquée au lot en sortie
+    const std::size_t n = controlPoints.size();
+    if (method == BezierMethod::Simd) {
+        evaluateSimd(ts, count, out);
+    } else if (method != BezierMethod::DeCasteljau) {
+        for (std::size_t k = 0; k < count; ++k)
+            out[k] = evaluateLocal(ts[k], method);
+    } else if (Kernel kernel = deCasteljauKernel(n)) {
+        for (std::size_t k = 0; k < count; ++k)
+            out[k] = kernel(controlPoints.data(), ts[k]);
+    } else {
+        glm::vec2* temp = scratchBuffer(n);
+        for (std::size_t k = 0; k < count; ++k) {
+            std::copy(controlPoints.begin(), controlPoints.end(), temp);
+            out[k] = reduceInPlace(temp, n, ts[k]);
+        }
+    }
+    toWorld(out, count);
+}
+
+void BezierCurveData::toWorld(glm::vec2* points, std::size_t count) const {
+    if (transformed) transformPoints(transform, points, points, count);
+}
+
+void BezierCurveData::evaluateMany(const std::vector<float>& ts, std::vector<glm::vec2>& out,
+                                   BezierMethod method) const {
+    out.resize(ts.size());
+    evaluateMany(ts.data(), ts.size(), out.data(), method);
+}
+
+void BezierCurveData::evaluateSimd(const float* ts, std::size_t count, glm::vec2* out) const {
+    // Passage en structure de tableaux pour que chaque voie SIMD traite un t différent
+    thread_local std::vector<float> xs, ys;
+    xs.resize(controlPoints.size());
+    ys.resize(controlPoints.size());
+    for (std::size_t i = 0; i < controlPoints.size(); ++i) {
+        xs[i] = controlPoints[i].x;
+        ys[i] = controlPoints[i].y;
+    }
+    evaluateBezierSoA(xs.data(), ys.data(), controlPoints.size(), ts, count, out);
+}
+
+void BezierCurveData::sampleUniform(int segments, glm::vec2* out, BezierMethod method) const {
+    if (segments < 1) segments = 1;
+    if (controlPoints.empty()) {
+        std::fill(out, out + segments + 1, glm::vec2(0.0f));
+        return;
+    }
+
+    if (method == BezierMethod::ForwardDifference) {
+        sampleForwardDifference(segments, out);
+        toWorld(out, segments + 1);
+        return;
+    }
+
+    thread_local std::vector<float> ts;
+    ts.resize(segments + 1);
+    for (int i = 0; i <= segments; ++i)
+        ts[i] = i / (float)segments;
+    evaluateMany(ts.data(), ts.size(), out, method);
+}
+
+void BezierCurveData::flatten(float tolerance, std::vector<glm::vec2>& out, int maxDepth) const {
+    out.clear();
+    if (controlPoints.empty()) return;
+
+    // La transformation étant affine, on aplatit directement le polygone transformé
+    const std::vector<glm::vec2>& points = worldControlPoints();
+    const std::size_t n = points.size();
+    out.push_back(points.front());
+    if (n == 1) return;
+
+    // Pile explicite de morceaux (n points chacun) : le gauche est toujours traité avant le droit
+    thread_local std::vector<glm::vec2> stack, piece, temp;
+    thread_local std::vector<int> depths;
+    piece.resize(n);
+    temp.resize(n);
+    stack.assign(points.begin(), points.end());
+    depths.assign(1, 0);
+
+    while (!depths.empty()) {
+        const int depth = depths.back();
+        depths.pop_back();
+        std::copy(stack.end() - n, stack.end(), piece.begin());
+        stack.resize(stack.size() - n);
+
+        if (depth >= maxDepth || isFlat(piece.data(), n, tolerance)) {
+            out.push_back(piece[n - 1]);
+            continue;
+        }
+
+        stack.resize(stack.size() + 2 * n);
+        glm::vec2* right = stack.data() + stack.size() - 2 * n;
+        glm::vec2* left = right + n;
+        splitHalf(piece.data(), n, left, right, temp.data());
+        depths.push_back(depth + 1);
+        depths.push_back(depth + 1);
+    }
+}
+
+void BezierCurveData::sample(const SamplingOptions& options, std::vector<glm::vec2>& out) const {
+    if (controlPoints.size() < 2) {
+        out.clear();
+        return;
+    }
+
+    if (options.mode == SamplingMode::Adaptive) {
+        flatten(options.tolerance, out);
+        return;
+    }
+
+    out.resize(std::max(options.segments, 1) + 1);
+    if (options.mode == SamplingMode::ArcLength)
+        sampleArcLength(options.segments, out.data(), options.method);
+    else
+        sampleUniform(options.segments, out.data(), options.method);
+}
+
+bool BezierCurveData::hasSampled(const SamplingOptions& options) const {
+    return cachedSamplesVersion == editVersion && sameSampling(cachedSampling, options);
+}
+
+const std::vector<glm::vec2>& BezierCurveData::sampled(const SamplingOptions& options) const {
+    if (hasSampled(options)) {
+        sampleCacheHits.fetch_add(1, std::memory_order_relaxed);
+        return cachedSamples;
+    }
+
+    sampleCacheMisses.fetch_add(1, std::memory_order_relaxed);
+    sample(options, cachedSamples);
+    cachedSampling = options;
+    cachedSamplesVersion = editVersion;
+    return cachedSamples;
+}
+
+SampleCacheStats BezierCurveData::sampleCacheStats() {
+    SampleCacheStats stats;
+    stats.hits = sampleCacheHits.load(std::memory_order_relaxed);
+    stats.misses = sampleCacheMisses.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BezierCurveData::resetSampleCacheStats() {
+    sampleCacheHits.store(0, std::memory_order_relaxed);
+    sampleCacheMisses.store(0, std::memory_order_relaxed);
+}
+
+void BezierCurveData::sampleForwardDifference(int segments, glm::vec2* out) const {
+    const std::size_t n = controlPoints.size();
+    const double h = 1.0 / segments;
+
+    double extent = 0.0;
+    for (const auto& p : controlPoints)
+        extent = std::max(extent, (double)std::max(std::abs(p.x), std::abs(p.y)));
+    const double tolerance = std::numeric_limits<float>::epsilon() * std::max(extent, 1e-30);
+
+    thread_local std::vector<glm::dvec2> table;
+    table.resize(n);
+
+    int i = 0;
+    while (i <= segments) {
+        seedDifferenceTable(i * h, h, table.data());
+
+        // Plus long parcours dont la dérive reste sous la précision d'un float
+        // (la borne croît avec m : recherche dichotomique, le cas courant passe du premier coup)
+        int run = std::min(kForwardDifferenceReseedInterval, segments - i);
+        if (forwardDifferenceDrift(table.data(), n, run, extent) > tolerance) {
+            int lo = 0, hi = run;
+            while (hi - lo > 1) {
+                const int mid = (lo + hi) / 2;
+                if (forwardDifferenceDrift(table.data(), n, mid, extent) <= tolerance) lo = mid;
+                else hi = mid;
+            }
+            run = lo;
+        }
+
+        for (int m = 0; ; ++m) {
+            out[i + m] = glm::vec2(table[0]);
+            if (m == run) break;
+            for (std::size_t k = 0; k + 1 < n; ++k)
+                table[k] += table[k + 1];
+        }
+        i += run + 1;
+    }
+}
+
+// Remplit table[k] = Δ^k B(t0) pour un pas h, à partir de n évaluations exactes en double.
+void BezierCurveData::seedDifferenceTable(double t0, double h, glm::dvec2* table) const {
+    const std::size_t n = controlPoints.size();
+    thread_local std::vector<glm::dvec2> temp;
+    temp.resize(n);
+
+    for (std::size_t k = 0; k < n; ++k) {
+        const double t = t0 + k * h;
+        for (std::size_t i = 0; i < n; ++i) temp[i] = glm::dvec2(controlPoints[i]);
+        for (std::size_t level = n - 1; level > 0; --level)
+            for (std::size_t i = 0; i < level; ++i)
+                temp[i] = (1 - t) * temp[i] + t * temp[i + 1];
+        table[k] = temp[0];
+    }
+
+    for (std::size_t level = 1; level < n; ++level)
+        for (std::size_t k = n - 1; k >= level; --k)
+            table[k] -= table[k - 1];
 }
 
 glm::vec2 BezierCurveData::deCasteljau(float t) const {
@@ -12,71 +332,224 @@ glm::vec2 BezierCurveData::deCasteljau(float t) const {
         return glm::vec2(0.0f);  // ou glm::vec2(NaN) si tu veux détecter l'erreur
     }
 
-    std::vector<glm::vec2> temp = controlPoints;
+    if (Kernel kernel = deCasteljauKernel(controlPoints.size()))
+        return kernel(controlPoints.data(), t);
+
+    glm::vec2* temp = scratchBuffer(controlPoints.size());
+    std::copy(controlPoints.begin(), controlPoints.end(), temp);
+    return reduceInPlace(temp, controlPoints.size(), t);
+}
+
+
+void BezierCurveData::evaluateDifferentials(const float* ts, std::size_t count, CurveDifferential* out) const {
+    const std::size_t n = controlPoints.size();
+    if (n == 0) {
+        std::fill(out, out + count, CurveDifferential());
+        return;
+    }
 
-    while (temp.size() > 1) {
-        std::vector<glm::vec2> next;
-        for (size_t i = 0; i < temp.size() - 1; ++i) {
-            glm::vec2 p = (1 - t) * temp[i] + t * temp[i + 1];
-            next.push_back(p);
+    const float degree = static_cast<float>(n - 1);
+    glm::vec2* temp = scratchBuffer(n);
+
+    for (std::size_t k = 0; k < count; ++k) {
+        const float t = ts[k];
+        std::copy(controlPoints.begin(), controlPoints.end(), temp);
+
+        // Réduction jusqu'à trois points q0, q1, q2 : B'' = n(n-1)(q2 - 2q1 + q0)
+        for (std::size_t level = n - 1; level > 2; --level)
+            for (std::size_t i = 0; i < level; ++i)
+                temp[i] = (1 - t) * temp[i] + t * temp[i + 1];
+
+        CurveDifferential& d = out[k];
+        glm::vec2 r0 = temp[0], r1 = temp[std::min<std::size_t>(1, n - 1)];
+        if (n >= 3) {
+            d.secondDerivative = degree * (degree - 1) * (temp[2] - 2.0f * temp[1] + temp[0]);
+            r0 = (1 - t) * temp[0] + t * temp[1];
+            r1 = (1 - t) * temp[1] + t * temp[2];
+        } else {
+            d.secondDerivative = glm::vec2(0.0f);
+        }
+
+        // Avant-dernier niveau : B' = n(r1 - r0)
+        d.firstDerivative = degree * (r1 - r0);
+        d.position = (1 - t) * r0 + t * r1;
+
+        if (transformed) {
+            const glm::mat2 linear(transform);
+            d.position = transformPoint(transform, d.position);
+            d.firstDerivative = linear * d.firstDerivative;
+            d.secondDerivative = linear * d.secondDerivative;
+        }
+
+        const float speed = glm::length(d.firstDerivative);
+        const float cross = d.firstDerivative.x * d.secondDerivative.y - d.firstDerivative.y * d.secondDerivative.x;
+        d.curvature = (speed > 0.0f) ? cross / (speed * speed * speed) : 0.0f;
+    }
+}
+
+const std::vector<glm::dvec2>& BezierCurveData::hodograph(int order) const {
+    if (hodographVersion != pointsVersion) {
+        // Q_i = n (P_{i+1} - P_i), puis R_i = (n - 1)(Q_{i+1} - Q_i)
+        thread_local std::vector<glm::dvec2> points;
+        points.assign(controlPoints.begin(), controlPoints.end());
+        const std::vector<glm::dvec2>* source = &points;
+        for (auto& h : hodographs) {
+            const std::size_t count = source->empty() ? 0 : source->size() - 1;
+            h.resize(count);
+            for (std::size_t i = 0; i < count; ++i)
+                h[i] = static_cast<double>(count) * ((*source)[i + 1] - (*source)[i]);
+            source = &h;
         }
-        temp = next;
+        hodographVersion = pointsVersion;
     }
+    return hodographs[glm::clamp(order, 1, 2) - 1];
+}
+
+glm::vec2 BezierCurveData::derivative(float t, int order) const {
+    const std::vector<glm::dvec2>& h = hodograph(order);
+    if (h.empty()) return glm::vec2(0.0f);
+
+    thread_local std::vector<glm::dvec2> temp;
+    temp.assign(h.begin(), h.end());
+    for (std::size_t level = temp.size() - 1; level > 0; --level)
+        for (std::size_t i = 0; i < level; ++i)
+            temp[i] = (1.0 - t) * temp[i] + static_cast<double>(t) * temp[i + 1];
+    const glm::vec2 d(temp[0]);
+    return transformed ? glm::mat2(transform) * d : d;
+}
+
+void BezierCurveData::prepareCaches(BezierMethod method) const {
+    if (method == BezierMethod::Horner) monomialCoefficients();
+}
+
+// Coefficients a_j de B(t) = Σ a_j t^j, recalculés uniquement quand la version change :
+// a_j = C(n, j) * Δ^j P_0 (différences avant des points de contrôle).
+const std::vector<glm::dvec2>& BezierCurveData::monomialCoefficients() const {
+    if (monomialVersion == pointsVersion) return monomial;
+
+    const std::size_t count = controlPoints.size();
+    monomial.assign(controlPoints.begin(), controlPoints.end());
+    for (std::size_t level = 1; level < count; ++level)
+        for (std::size_t k = count - 1; k >= level; --k)
+            monomial[k] -= monomial[k - 1];
+
+    const int n = static_cast<int>(count) - 1;
+    for (int j = 0; j <= n; ++j)
+        monomial[j] *= binomialCoefficient(n, j);
 
-    return temp[0];  // Maintenant sécurisé
+    monomialVersion = pointsVersion;
+    return monomial;
 }
 
+glm::vec2 BezierCurveData::evaluateHorner(float t) const {
+    const std::vector<glm::dvec2>& a = monomialCoefficients();
+    if (a.empty()) return glm::vec2(0.0f);
+
+    glm::dvec2 result = a.back();
+    for (std::size_t j = a.size() - 1; j > 0; --j)
+        result = result * static_cast<double>(t) + a[j - 1];
+    return glm::vec2(result);
+}
 
 /// B(t) = Σ_{i=0}^{n} C(n, i) * (1 - t)^{n - i} * t^i * P_i
+/// Les puissances de t et de (1 - t) sont obtenues par produits successifs, en double.
 glm::vec2 BezierCurveData::evaluateDirect(float t) const {
-    int n = static_cast<int>(controlPoints.size()) - 1;
-    glm::vec2 result(0.0f);
+    if (controlPoints.empty()) return glm::vec2(0.0f);
+    if (Kernel kernel = bernsteinKernel<double>(controlPoints.size()))
+        return kernel(controlPoints.data(), t);
+
+    const int n = static_cast<int>(controlPoints.size()) - 1;
+    const double u = t;
+    const double s = 1.0 - u;
+
+    thread_local std::vector<double> tPowers;
+    tPowers.resize(n + 1);
+    tPowers[0] = 1.0;
+    for (int i = 1; i <= n; ++i)
+        tPowers[i] = tPowers[i - 1] * u;
 
-    for (int i = 0; i <= n; ++i) {
-        int binCoeff = binomialCoefficient(n, i);
-        float term = binCoeff * std::pow(1 - t, n - i) * std::pow(t, i);
-        result += term * controlPoints[i];
+    // Au-delà de la table, C(n, i - 1) = C(n, i) * i / (n - i + 1) en partant de C(n, n) = 1
+    const double* row = (n <= kMaxTabulatedDegree) ? &kBinomials.values[BinomialTable::rowStart(n)] : nullptr;
+    double binCoeff = 1.0;
+    double sPower = 1.0;
+    glm::dvec2 result(0.0);
+
+    for (int i = n; i >= 0; --i) {
+        const double c = row ? row[i] : binCoeff;
+        result += (c * tPowers[i] * sPower) * glm::dvec2(controlPoints[i]);
+        sPower *= s;
+        binCoeff = binCoeff * i / (n - i + 1);
     }
 
-    return result;
+    return glm::vec2(result);
 }
 
-int BezierCurveData::binomialCoefficient(int n, int k) const {
-    if (k > n) return 0;
-    if (k == 0 || k == n) return 1;
-    int res = 1;
+double BezierCurveData::binomialCoefficient(int n, int k) {
+    if (k < 0 || k > n) return 0.0;
+    if (n <= kMaxTabulatedDegree) return kBinomials.values[BinomialTable::rowStart(n) + k];
+
+    k = std::min(k, n - k);
+    double res = 1.0;
     for (int i = 1; i <= k; ++i) {
         res = res * (n - i + 1) / i;
     }
     return res;
 }
 
+void BezierCurveData::addControlPoint(const glm::vec2& point) {
+    bake();
+    controlPoints.push_back(point);
+    markModified();
+}
+
 void BezierCurveData::applyTransformation(const glm::mat3& matrix) {
-    for (auto& point : controlPoints) {
-        glm::vec3 p(point, 1.0f);
-        p = matrix * p;
-        point = glm::vec2(p.x, p.y);
+    // Seule la géométrie change : les caches en repère local (monomiale, hodographe) restent valides
+    transform = matrix * transform;
+    transformed = true;
+    ++editVersion;
+}
+
+void BezierCurveData::bake() {
+    if (!transformed) return;
+    transformPoints(transform, controlPoints.data(), controlPoints.data(), controlPoints.size());
+    transform = glm::mat3(1.0f);
+    transformed = false;
+    ++pointsVersion;
+}
+
+const std::vector<glm::vec2>& BezierCurveData::worldControlPoints() const {
+    if (!transformed) return controlPoints;
+    if (worldPointsVersion != editVersion) {
+        worldPoints.resize(controlPoints.size());
+        transformPoints(transform, controlPoints.data(), worldPoints.data(), controlPoints.size());
+        worldPointsVersion = editVersion;
     }
+    return worldPoints;
 }
 
 void BezierCurveData::duplicateLastPoint() {
     if (!controlPoints.empty()) {
         controlPoints.push_back(controlPoints.back());
+        markModified();
     }
 }
 
 bool BezierCurveData::isClosed(float epsilon) const {
-    if (controlPoints.size() < 3) return false;
-    return glm::distance(controlPoints.front(), controlPoints.back()) < epsilon;
+    const std::vector<glm::vec2>& points = worldControlPoints();
+    if (points.size() < 3) return false;
+    return glm::distance(points.front(), points.back()) < epsilon;
 }
 
 void BezierCurveData::closeCurveC0() {
     if (controlPoints.empty()) return;
+    bake();
     controlPoints.push_back(controlPoints.front());
+    markModified();
 }
 
 void BezierCurveData::closeCurveC1() {
     if (controlPoints.size() < 2) return;
+    bake();
     glm::vec2 last = controlPoints.back();
     glm::vec2 beforeLast = controlPoints[controlPoints.size() - 2];
     glm::vec2 dir = glm::normalize(last - beforeLast);
@@ -85,10 +558,12 @@ void BezierCurveData::closeCurveC1() {
     glm::vec2 reflected = newStart + dir * glm::distance(newStart, penultimate);
     controlPoints.push_back(reflected);
     controlPoints.push_back(newStart);
+    markModified();
 }
 
 void BezierCurveData::closeCurveC2() {
     if (controlPoints.size() < 3) return;
+    bake();
     glm::vec2 p0 = controlPoints[controlPoints.size() - 3];
     glm::vec2 p1 = controlPoints[controlPoints.size() - 2];
     glm::vec2 p2 = controlPoints.back();
@@ -101,15 +576,21 @@ void BezierCurveData::closeCurveC2() {
     controlPoints.push_back(mirrored);
     controlPoints.push_back(newP1);
     controlPoints.push_back(newP2);
+    markModified();
 }
 
 void BezierCurveData::connectC0(BezierCurveData& next) {
     if (controlPoints.empty()) return;
+    bake();
+    next.bake();
     next.controlPoints.front() = controlPoints.back();
+    next.markModified();
 }
 
 void BezierCurveData::connectC1(BezierCurveData& next) {
     if (controlPoints.size() < 2 || next.controlPoints.size() < 2) return;
+    bake();
+    next.bake();
 
     // Assure la continuité C0
     next.controlPoints.front() = controlPoints.back();
@@ -121,10 +602,13 @@ void BezierCurveData::connectC1(BezierCurveData& next) {
 
     float len = glm::distance(next.controlPoints[0], next.controlPoints[1]);
     next.controlPoints[1] = next.controlPoints[0] + dir * len;
+    next.markModified();
 }
 
 void BezierCurveData::connectC2(BezierCurveData& next) {
     if (controlPoints.size() < 3 || next.controlPoints.size() < 3) return;
+    bake();
+    next.bake();
 
     // C0
     next.controlPoints.front() = controlPoints.back();
@@ -143,6 +627,7 @@ void BezierCurveData::connectC2(BezierCurveData& next) {
 
     glm::vec2 b2 = next.controlPoints[1];
     next.controlPoints[2] = 2.0f * b2 - next.controlPoints[0] + acc;
+    next.markModified();
 }
 
 
@@ -0,0 +1,239 @@
+#include "BezierSimd.hpp"
+#include "SimdTarget.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Niveaux intermédiaires de la réduction : n * largeur flottants par coordonnée.
+float* laneBuffer(std::vector<float>& buffer, std::size_t size) {
+    if (buffer.size() < size) buffer.resize(size);
+    return buffer.data();
+}
+
+void evaluateScalar(const float* xs, const float* ys, std::size_t n,
+                    const float* ts, std::size_t count, glm::vec2* out) {
+    thread_local std::vector<float> bufX, bufY;
+    float* wx = laneBuffer(bufX, n);
+    float* wy = laneBuffer(bufY, n);
+
+    for (std::size_t k = 0; k < count; ++k) {
+        const float t = ts[k];
+        const float s = 1 - t;
+        std::copy(xs, xs + n, wx);
+        std::copy(ys, ys + n, wy);
+        for (std::size_t level = n - 1; level > 0; --level) {
+            for (std::size_t i = 0; i < level; ++i) {
+                wx[i] = s * wx[i] + t * wx[i + 1];
+                wy[i] = s * wy[i] + t * wy[i + 1];
+            }
+        }
+        out[k] = glm::vec2(wx[0], wy[0]);
+    }
+}
+
+#ifdef BEZIER_SIMD_X86
+
+BEZIER_TARGET("sse2")
+void evaluateSse(const float* xs, const float* ys, std::size_t n,
+                 const float* ts, std::size_t count, glm::vec2* out) {
+    constexpr std::size_t W = 4;
+    thread_local std::vector<float> bufX, bufY;
+    float* wx = laneBuffer(bufX, n * W);
+    float* wy = laneBuffer(bufY, n * W);
+    alignas(16) float lanes[W], rx[W], ry[W];
+
+    for (std::size_t k = 0; k < count; k += W) {
+        const std::size_t m = std::min(W, count - k);
+        for (std::size_t j = 0; j < W; ++j) lanes[j] = ts[k + std::min(j, m - 1)];
+
+        const __m128 t = _mm_load_ps(lanes);
+        const __m128 s = _mm_sub_ps(_mm_set1_ps(1.0f), t);
+        __m128 x0 = _mm_set1_ps(xs[0]);
+        __m128 y0 = _mm_set1_ps(ys[0]);
+
+        // Premier niveau directement depuis les points de contrôle diffusés
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            __m128 x = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(xs[i])), _mm_mul_ps(t, _mm_set1_ps(xs[i + 1])));
+            __m128 y = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(ys[i])), _mm_mul_ps(t, _mm_set1_ps(ys[i + 1])));
+            _mm_storeu_ps(wx + i * W, x);
+            _mm_storeu_ps(wy + i * W, y);
+        }
+        for (std::size_t level = n - 1; level > 1; --level) {
+            for (std::size_t i = 0; i + 1 < level; ++i) {
+                __m128 a = _mm_loadu_ps(wx + i * W), b = _mm_loadu_ps(wx + (i + 1) * W);
+                __m128 c = _mm_loadu_ps(wy + i * W), d = _mm_loadu_ps(wy + (i + 1) * W);
+                _mm_storeu_ps(wx + i * W, _mm_add_ps(_mm_mul_ps(s, a), _mm_mul_ps(t, b)));
+                _mm_storeu_ps(wy + i * W, _mm_add_ps(_mm_mul_ps(s, c), _mm_mul_ps(t, d)));
+            }
+        }
+        if (n > 1) {
+            x0 = _mm_loadu_ps(wx);
+            y0 = _mm_loadu_ps(wy);
+        }
+
+        _mm_store_ps(rx, x0);
+        _mm_store_ps(ry, y0);
+        for (std::size_t j = 0; j < m; ++j) out[k + j] = glm::vec2(rx[j], ry[j]);
+    }
+}
+
+BEZIER_TARGET("avx2")
+void evaluateAvx2(const float* xs, const float* ys, std::size_t n,
+                  const float* ts, std::size_t count, glm::vec2* out) {
+    constexpr std::size_t W = 8;
+    thread_local std::vector<float> bufX, bufY;
+    float* wx = laneBuffer(bufX, n * W);
+    float* wy = laneBuffer(bufY, n * W);
+    alignas(32) float lanes[W], rx[W], ry[W];
+
+    for (std::size_t k = 0; k < count; k += W) {
+        const std::size_t m = std::min(W, count - k);
+        for (std::size_t j = 0; j < W; ++j) lanes[j] = ts[k + std::min(j, m - 1)];
+
+        const __m256 t = _mm256_load_ps(lanes);
+        const __m256 s = _mm256_sub_ps(_mm256_set1_ps(1.0f), t);
+        __m256 x0 = _mm256_set1_ps(xs[0]);
+        __m256 y0 = _mm256_set1_ps(ys[0]);
+
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            __m256 x = _mm256_add_ps(_mm256_mul_ps(s, _mm256_set1_ps(xs[i])), _mm256_mul_ps(t, _mm256_set1_ps(xs[i + 1])));
+            __m256 y = _mm256_add_ps(_mm256_mul_ps(s, _mm256_set1_ps(ys[i])), _mm256_mul_ps(t, _mm256_set1_ps(ys[i + 1])));
+            _mm256_storeu_ps(wx + i * W, x);
+            _mm256_storeu_ps(wy + i * W, y);
+        }
+        for (std::size_t level = n - 1; level > 1; --level) {
+            for (std::size_t i = 0; i + 1 < level; ++i) {
+                __m256 a = _mm256_loadu_ps(wx + i * W), b = _mm256_loadu_ps(wx + (i + 1) * W);
+                __m256 c = _mm256_loadu_ps(wy + i * W), d = _mm256_loadu_ps(wy + (i + 1) * W);
+                _mm256_storeu_ps(wx + i * W, _mm256_add_ps(_mm256_mul_ps(s, a), _mm256_mul_ps(t, b)));
+                _mm256_storeu_ps(wy + i * W, _mm256_add_ps(_mm256_mul_ps(s, c), _mm256_mul_ps(t, d)));
+            }
+        }
+        if (n > 1) {
+            x0 = _mm256_loadu_ps(wx);
+            y0 = _mm256_loadu_ps(wy);
+        }
+
+        _mm256_store_ps(rx, x0);
+        _mm256_store_ps(ry, y0);
+        for (std::size_t j = 0; j < m; ++j) out[k + j] = glm::vec2(rx[j], ry[j]);
+    }
+}
+
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float), "glm::vec2 lu comme deux flottants contigus");
+
+// Points entrelacés (x0 y0 x1 y1 ...) : v * (m00, m11) + permute(v) * (m10, m01) + (m20, m21)
+BEZIER_TARGET("sse2")
+std::size_t transformSse(const glm::mat3& m, const glm::vec2* in, glm::vec2* out, std::size_t count) {
+    const __m128 diagonal = _mm_setr_ps(m[0][0], m[1][1], m[0][0], m[1][1]);
+    const __m128 cross = _mm_setr_ps(m[1][0], m[0][1], m[1][0], m[0][1]);
+    const __m128 offset = _mm_setr_ps(m[2][0], m[2][1], m[2][0], m[2][1]);
+    const float* src = &in[0].x;
+    float* dst = &out[0].x;
+    std::size_t k = 0;
+    for (; k + 2 <= count; k += 2) {
+        const __m128 v = _mm_loadu_ps(src + 2 * k);
+        const __m128 swapped = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(dst + 2 * k, _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, diagonal), _mm_mul_ps(swapped, cross)), offset));
+    }
+    return k;
+}
+
+BEZIER_TARGET("avx2")
+std::size_t transformAvx2(const glm::mat3& m, const glm::vec2* in, glm::vec2* out, std::size_t count) {
+    const __m256 diagonal = _mm256_setr_ps(m[0][0], m[1][1], m[0][0], m[1][1], m[0][0], m[1][1], m[0][0], m[1][1]);
+    const __m256 cross = _mm256_setr_ps(m[1][0], m[0][1], m[1][0], m[0][1], m[1][0], m[0][1], m[1][0], m[0][1]);
+    const __m256 offset = _mm256_setr_ps(m[2][0], m[2][1], m[2][0], m[2][1], m[2][0], m[2][1], m[2][0], m[2][1]);
+    const float* src = &in[0].x;
+    float* dst = &out[0].x;
+    std::size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m256 v = _mm256_loadu_ps(src + 2 * k);
+        const __m256 swapped = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm256_storeu_ps(dst + 2 * k, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v, diagonal), _mm256_mul_ps(swapped, cross)), offset));
+    }
+    return k;
+}
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool cpuHasSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif
+
+}
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = [] {
+#ifdef BEZIER_SIMD_X86
+        if (cpuHasAvx2()) return SimdLevel::AVX2;
+        if (cpuHasSse2()) return SimdLevel::SSE;
+#endif
+        return SimdLevel::Scalar;
+    }();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE: return "SSE";
+        default: return "scalaire";
+    }
+}
+
+void evaluateBezierSoA(const float* xs, const float* ys, std::size_t n,
+                       const float* ts, std::size_t count, glm::vec2* out) {
+    if (n == 0) {
+        std::fill(out, out + count, glm::vec2(0.0f));
+        return;
+    }
+
+    switch (detectSimdLevel()) {
+#ifdef BEZIER_SIMD_X86
+        case SimdLevel::AVX2: evaluateAvx2(xs, ys, n, ts, count, out); return;
+        case SimdLevel::SSE: evaluateSse(xs, ys, n, ts, count, out); return;
+#endif
+        default: evaluateScalar(xs, ys, n, ts, count, out); return;
+    }
+}
+
+void transformPoints(const glm::mat3& m, const glm::vec2* in, glm::vec2* out, std::size_t count) {
+    if (count == 0) return;
+    std::size_t done = 0;
+    switch (detectSimdLevel()) {
+#ifdef BEZIER_SIMD_X86
+        case SimdLevel::AVX2: done = transformAvx2(m, in, out, count); break;
+        case SimdLevel::SSE: done = transformSse(m, in, out, count); break;
+#endif
+        default: break;
+    }
+    for (std::size_t k = done; k < count; ++k) out[k] = transformPoint(m, in[k]);
+}
@@ -0,0 +1,175 @@
+#include "CompositeBezier.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Forme de Bernstein directe du cubique : coût constant par point
+glm::vec2 evaluateCubic(const std::vector<glm::vec2>& p, float t) {
+    const float s = 1.0f - t;
+    return (s * s * s) * p[0] + (3.0f * s * s * t) * p[1] + (3.0f * s * t * t) * p[2] + (t * t * t) * p[3];
+}
+
+// Position et dérivée de la courbe source en t (De Casteljau en double sur les points et l'hodographe en cache)
+struct CurveSampler {
+    const std::vector<glm::vec2>& points;
+    const std::vector<glm::dvec2>& hodograph;
+    std::vector<glm::dvec2> temp;
+
+    explicit CurveSampler(const BezierCurveData& curve)
+        : points(curve.controlPoints), hodograph(curve.hodograph(1)), temp(curve.controlPoints.size()) {}
+
+    glm::dvec2 reduce(std::size_t n, double t) {
+        for (std::size_t level = n - 1; level > 0; --level)
+            for (std::size_t i = 0; i < level; ++i)
+                temp[i] = (1 - t) * temp[i] + t * temp[i + 1];
+        return temp[0];
+    }
+
+    glm::dvec2 position(double t) {
+        for (std::size_t i = 0; i < points.size(); ++i) temp[i] = glm::dvec2(points[i]);
+        return reduce(points.size(), t);
+    }
+
+    glm::dvec2 derivative(double t) {
+        std::copy(hodograph.begin(), hodograph.end(), temp.begin());
+        return reduce(hodograph.size(), t);
+    }
+};
+
+// Nombre de points de contrôle utilisés pour mesurer l'écart d'un segment
+constexpr int kErrorSamples = 8;
+
+void convertRange(CurveSampler& source, double a, double b, float tolerance, int depth,
+                  CompositeBezier& result) {
+    const double h = b - a;
+    const glm::dvec2 p0 = source.position(a);
+    const glm::dvec2 p3 = source.position(b);
+    const glm::dvec2 p1 = p0 + source.derivative(a) * (h / 3.0);
+    const glm::dvec2 p2 = p3 - source.derivative(b) * (h / 3.0);
+    const std::vector<glm::vec2> cubic{glm::vec2(p0), glm::vec2(p1), glm::vec2(p2), glm::vec2(p3)};
+
+    float error = 0.0f;
+    for (int k = 1; k < kErrorSamples; ++k) {
+        const float t = k / (float)kErrorSamples;
+        const glm::vec2 exact(source.position(a + h * t));
+        error = std::max(error, glm::distance(exact, evaluateCubic(cubic, t)));
+    }
+
+    if (error > tolerance && depth > 0) {
+        const double mid = 0.5 * (a + b);
+        convertRange(source, a, mid, tolerance, depth - 1, result);
+        convertRange(source, mid, b, tolerance, depth - 1, result);
+        return;
+    }
+
+    result.appendSegment(cubic[0], cubic[1], cubic[2], cubic[3]);
+}
+
+}
+
+glm::vec2 CompositeBezier::point(std::size_t index) const {
+    if (index == pointCount() - 1) return segments.back().controlPoints[3];
+    return segments[index / 3].controlPoints[index % 3];
+}
+
+void CompositeBezier::setPoint(std::size_t index, const glm::vec2& p) {
+    const std::size_t segment = index / 3;
+    const std::size_t local = index % 3;
+
+    if (local == 0 && segment > 0) {
+        segments[segment - 1].controlPoints[3] = p;
+        segments[segment - 1].markModified();
+    }
+    if (segment < segments.size()) {
+        segments[segment].controlPoints[local] = p;
+        segments[segment].markModified();
+    }
+}
+
+void CompositeBezier::appendSegment(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3) {
+    BezierCurveData segment;
+    segment.controlPoints = {segments.empty() ? p0 : segments.back().controlPoints[3], p1, p2, p3};
+    segments.push_back(std::move(segment));
+}
+
+void CompositeBezier::appendSegment(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3) {
+    appendSegment(segments.empty() ? p1 : segments.back().controlPoints[3], p1, p2, p3);
+}
+
+void CompositeBezier::enforceContinuity(int order) {
+    for (std::size_t i = 0; i + 1 < segments.size(); ++i) {
+        if (order >= 2) segments[i].connectC2(segments[i + 1]);
+        else if (order == 1) segments[i].connectC1(segments[i + 1]);
+        else segments[i].connectC0(segments[i + 1]);
+    }
+}
+
+glm::vec2 CompositeBezier::evaluate(float u) const {
+    if (segments.empty()) return glm::vec2(0.0f);
+    const float clamped = glm::clamp(u, 0.0f, (float)segments.size());
+    const std::size_t index = std::min(static_cast<std::size_t>(clamped), segments.size() - 1);
+    return evaluateCubic(segments[index].controlPoints, clamped - index);
+}
+
+void CompositeBezier::sample(const SamplingOptions& options, std::vector<glm::vec2>& out) const {
+    out.clear();
+    if (segments.empty()) return;
+
+    if (options.mode == SamplingMode::Adaptive) {
+        std::vector<glm::vec2> piece;
+        for (const auto& segment : segments) {
+            segment.flatten(options.tolerance, piece);
+            out.insert(out.end(), piece.begin() + (out.empty() ? 0 : 1), piece.end());
+        }
+        return;
+    }
+
+    // Nombre d'intervalles par segment : part égale en Uniform, proportionnelle à la longueur du
+    // segment en ArcLength (bornes cumulées arrondies, au moins un intervalle par segment)
+    thread_local std::vector<int> counts;
+    counts.assign(segments.size(), std::max(1, (options.segments + (int)segments.size() - 1) / (int)segments.size()));
+    if (options.mode == SamplingMode::ArcLength) {
+        float total = 0.0f;
+        for (const auto& segment : segments) total += segment.length();
+        if (total > 0.0f) {
+            const int target = std::max(options.segments, (int)segments.size());
+            float covered = 0.0f;
+            int previous = 0;
+            for (std::size_t i = 0; i < segments.size(); ++i) {
+                covered += segments[i].length();
+                const int boundary = (int)std::lround(target * (covered / total));
+                counts[i] = std::max(1, boundary - previous);
+                previous += counts[i];
+            }
+        }
+    }
+
+    std::size_t size = 1;
+    for (int count : counts) size += count;
+    out.resize(size);
+    // Chaque segment écrit ses count + 1 points ; le premier recouvre la jonction du précédent
+    glm::vec2* next = out.data();
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        if (options.mode == SamplingMode::ArcLength)
+            segments[i].sampleArcLength(counts[i], next, options.method);
+        else
+            segments[i].sampleUniform(counts[i], next, options.method);
+        next += counts[i];
+    }
+}
+
+CompositeBezier CompositeBezier::fromCurve(const BezierCurveData& curve, float tolerance, int maxDepth) {
+    CompositeBezier result;
+    if (curve.controlPoints.size() < 2) return result;
+    if (curve.hasTransformation()) {
+        // Le convertisseur lit les points et l'hodographe en repère local : copie transformée
+        BezierCurveData baked = curve;
+        baked.bake();
+        return fromCurve(baked, tolerance, maxDepth);
+    }
+
+    CurveSampler source(curve);
+    convertRange(source, 0.0, 1.0, tolerance, maxDepth, result);
+    return result;
+}
@@ -0,0 +1,212 @@
+#include "CompositeBezier.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Nombre maximal de reparamétrisations de Newton avant de découper une plage
+constexpr int kMaxIterations = 4;
+// Au-delà de cette taille, le point de découpage est ramené dans la moitié centrale de la plage
+constexpr std::size_t kBalancedSplitPoints = 1024;
+// Les tangentes sont estimées sur des points distants d'au moins ce multiple de la tolérance :
+// sur un trait dense et bruité, les voisins immédiats ne donnent qu'une direction de bruit.
+constexpr double kTangentRadius = 4.0;
+
+struct Cubic {
+    glm::dvec2 p[4];
+
+    glm::dvec2 at(double t) const {
+        const double s = 1.0 - t;
+        return (s * s * s) * p[0] + (3.0 * s * s * t) * p[1] + (3.0 * s * t * t) * p[2] + (t * t * t) * p[3];
+    }
+    glm::dvec2 firstDerivative(double t) const {
+        const double s = 1.0 - t;
+        return 3.0 * ((s * s) * (p[1] - p[0]) + (2.0 * s * t) * (p[2] - p[1]) + (t * t) * (p[3] - p[2]));
+    }
+    glm::dvec2 secondDerivative(double t) const {
+        return 6.0 * ((1.0 - t) * (p[2] - 2.0 * p[1] + p[0]) + t * (p[3] - 2.0 * p[2] + p[1]));
+    }
+};
+
+// Plage [first, last] à ajuster, avec les tangentes imposées à ses extrémités (vers l'intérieur)
+struct Range {
+    std::size_t first, last;
+    glm::dvec2 leftTangent, rightTangent;
+};
+
+glm::dvec2 normalizedOr(const glm::dvec2& v, const glm::dvec2& fallback) {
+    const double len = glm::length(v);
+    return (len > 0.0) ? v / len : fallback;
+}
+
+class Fitter {
+public:
+    Fitter(std::vector<glm::dvec2> input, double tolerance)
+        : pts(std::move(input)), tolerance2(tolerance * tolerance), radius(kTangentRadius * tolerance) {}
+
+    void run(CompositeBezier& result) {
+        const std::size_t n = pts.size();
+        const glm::dvec2 left = normalizedOr(pts[reach(0, n - 1)] - pts[0], glm::dvec2(1.0, 0.0));
+        const glm::dvec2 right = normalizedOr(pts[reach(n - 1, 0)] - pts[n - 1], -left);
+
+        // Pile explicite : la plage de gauche est toujours traitée avant celle de droite
+        std::vector<Range> stack{{0, n - 1, left, right}};
+        while (!stack.empty()) {
+            const Range range = stack.back();
+            stack.pop_back();
+
+            Cubic cubic;
+            std::size_t split;
+            if (fitRange(range, cubic, split)) {
+                result.appendSegment(glm::vec2(cubic.p[0]), glm::vec2(cubic.p[1]), glm::vec2(cubic.p[2]), glm::vec2(cubic.p[3]));
+                continue;
+            }
+
+            // Tangente commune au point de découpage : les deux morceaux se raccordent en G1
+            const std::size_t before = reach(split, range.first), after = reach(split, range.last);
+            const glm::dvec2 center = normalizedOr(pts[before] - pts[after],
+                                                   normalizedOr(pts[before] - pts[split], range.leftTangent));
+            stack.push_back({split, range.last, -center, range.rightTangent});
+            stack.push_back({range.first, split, range.leftTangent, center});
+        }
+    }
+
+private:
+    std::vector<glm::dvec2> pts;
+    double tolerance2;
+    double radius;
+    std::vector<double> u;
+
+    // Premier point à au moins radius de pts[from] en allant vers limit (limit s'il n'y en a pas)
+    std::size_t reach(std::size_t from, std::size_t limit) const {
+        const double radius2 = radius * radius;
+        std::size_t i = from;
+        do {
+            i = (limit > from) ? i + 1 : i - 1;
+            const glm::dvec2 d = pts[i] - pts[from];
+            if (glm::dot(d, d) >= radius2) break;
+        } while (i != limit);
+        return i;
+    }
+
+    // Ajuste une cubique sur la plage ; renvoie faux et l'indice du plus grand écart si elle ne suffit pas.
+    bool fitRange(const Range& range, Cubic& cubic, std::size_t& split) {
+        const std::size_t first = range.first, last = range.last;
+        const glm::dvec2 &a = pts[first], &b = pts[last];
+
+        if (last - first == 1) {
+            const double third = glm::distance(a, b) / 3.0;
+            cubic = Cubic{{a, a + range.leftTangent * third, b + range.rightTangent * third, b}};
+            return true;
+        }
+
+        chordLengthParameters(first, last);
+        generate(range, cubic);
+        double error = maxError(first, cubic, split);
+        if (error <= tolerance2) return true;
+
+        // Proche du but : les paramètres de corde sont améliorés par Newton avant de découper
+        if (error <= 16.0 * tolerance2) {
+            for (int iteration = 0; iteration < kMaxIterations; ++iteration) {
+                reparameterize(first, cubic);
+                generate(range, cubic);
+                error = maxError(first, cubic, split);
+                if (error <= tolerance2) return true;
+            }
+        }
+
+        const std::size_t count = last - first + 1;
+        if (count > kBalancedSplitPoints)
+            split = std::clamp(split, first + count / 4, last - count / 4);
+        return false;
+    }
+
+    void chordLengthParameters(std::size_t first, std::size_t last) {
+        const std::size_t count = last - first + 1;
+        u.resize(count);
+        u[0] = 0.0;
+        for (std::size_t i = 1; i < count; ++i)
+            u[i] = u[i - 1] + glm::distance(pts[first + i], pts[first + i - 1]);
+        const double total = u.back();
+        for (std::size_t i = 1; i < count; ++i) u[i] /= total;
+    }
+
+    // Moindres carrés sur les longueurs des poignées, directions des tangentes fixées
+    void generate(const Range& range, Cubic& cubic) const {
+        const std::size_t first = range.first, last = range.last;
+        const glm::dvec2 &a = pts[first], &b = pts[last];
+        const glm::dvec2 &t1 = range.leftTangent, &t2 = range.rightTangent;
+
+        double c00 = 0.0, c01 = 0.0, c11 = 0.0, x0 = 0.0, x1 = 0.0;
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            const double t = u[i], s = 1.0 - t;
+            const double b0 = s * s * s, b1 = 3.0 * s * s * t, b2 = 3.0 * s * t * t, b3 = t * t * t;
+            const glm::dvec2 a1 = t1 * b1, a2 = t2 * b2;
+            c00 += glm::dot(a1, a1);
+            c01 += glm::dot(a1, a2);
+            c11 += glm::dot(a2, a2);
+            const glm::dvec2 residual = pts[first + i] - (a * (b0 + b1) + b * (b2 + b3));
+            x0 += glm::dot(a1, residual);
+            x1 += glm::dot(a2, residual);
+        }
+
+        const double det = c00 * c11 - c01 * c01;
+        double alpha1 = 0.0, alpha2 = 0.0;
+        if (std::abs(det) > 1e-12 * c00 * c11) {
+            alpha1 = (x0 * c11 - x1 * c01) / det;
+            alpha2 = (c00 * x1 - c01 * x0) / det;
+        }
+
+        // Poignées nulles ou retournées : repli sur un tiers de la corde (comme Schneider)
+        const double chord = glm::distance(a, b);
+        if (alpha1 < 1e-6 * chord || alpha2 < 1e-6 * chord) alpha1 = alpha2 = chord / 3.0;
+        cubic = Cubic{{a, a + t1 * alpha1, b + t2 * alpha2, b}};
+    }
+
+    // Plus grand écart au carré entre un point et la cubique à son paramètre
+    double maxError(std::size_t first, const Cubic& cubic, std::size_t& split) const {
+        double worst = 0.0;
+        split = first + u.size() / 2;
+        for (std::size_t i = 1; i + 1 < u.size(); ++i) {
+            const glm::dvec2 d = cubic.at(u[i]) - pts[first + i];
+            const double error = glm::dot(d, d);
+            if (error > worst) {
+                worst = error;
+                split = first + i;
+            }
+        }
+        return worst;
+    }
+
+    // Un pas de Newton par point sur (Q(u) - P) · Q'(u) = 0
+    void reparameterize(std::size_t first, const Cubic& cubic) {
+        for (std::size_t i = 1; i + 1 < u.size(); ++i) {
+            const double t = u[i];
+            const glm::dvec2 d = cubic.at(t) - pts[first + i];
+            const glm::dvec2 q1 = cubic.firstDerivative(t), q2 = cubic.secondDerivative(t);
+            const double denominator = glm::dot(q1, q1) + glm::dot(d, q2);
+            if (std::abs(denominator) > 1e-300) u[i] = glm::clamp(t - glm::dot(d, q1) / denominator, 0.0, 1.0);
+        }
+    }
+};
+
+}
+
+CompositeBezier CompositeBezier::fit(const glm::vec2* points, std::size_t count, float tolerance) {
+    CompositeBezier result;
+
+    // Les doublons consécutifs donneraient des cordes nulles
+    std::vector<glm::dvec2> unique;
+    unique.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        if (unique.empty() || glm::dvec2(points[i]) != unique.back()) unique.emplace_back(points[i]);
+    if (unique.size() < 2) return result;
+
+    Fitter(std::move(unique), std::max(tolerance, 0.0f)).run(result);
+    result.enforceContinuity(1);
+    return result;
+}
+
+CompositeBezier CompositeBezier::fit(const std::vector<glm::vec2>& points, float tolerance) {
+    return fit(points.data(), points.size(), tolerance);
+}
@@ -4,177 +4,718 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include "../include/Extrusion.hpp"
+#include "../include/BezierSimd.hpp"
+#include "../include/SimdTarget.hpp"
+#include <algorithm>
+#include <cmath>
 #include "../external/glm/glm/glm.hpp"
 #include "../external/glm/glm/gtx/transform.hpp"
 #include "../external/glm/glm/gtc/constants.hpp"
 
 float pi = 3.14159265358;
 
-Mesh extrudeLinear(const std::vector<glm::vec2>& profile, float height, float scaleTop) {
-    Mesh mesh;
-    int n = profile.size();
-    if (n < 3) return mesh;  // au moins un polygone
+namespace {
+
+// Sommets par tâche : en dessous, réveiller un thread coûte plus que générer ses anneaux
+constexpr std::size_t kMinVerticesPerTask = 1 << 14;
+
+// Exécute fn(first, last) sur des plages contiguës de [0, count), chaque indice produisant
+// perItem sommets ; un petit maillage reste sur le thread appelant. Un indice est traité par
+// le même code quel que soit le découpage : le résultat ne dépend pas du nombre de threads.
+template <typename Fn>
+void forEachRange(ThreadPool& pool, std::size_t count, std::size_t perItem, const Fn& fn) {
+    const std::size_t useful = std::max<std::size_t>(count * perItem / kMinVerticesPerTask, 1);
+    const std::size_t spread = (pool.size() > 1) ? 4 * std::size_t(pool.size()) : 1;  // marge pour le vol
+    const std::size_t tasks = std::min({count, useful, spread});
+    if (tasks <= 1) {
+        fn(std::size_t(0), count);
+        return;
+    }
+    pool.parallelFor(tasks, [&](std::size_t k) { fn(count * k / tasks, count * (k + 1) / tasks); });
+}
 
-    // Étape 1 : base (z=0)
-    for (const auto& p : profile)
-        mesh.vertices.push_back(glm::vec3(p, 0.0f));
+// Rotation d'un anneau : x[j] = r[j] c, y[j] = r[j] s. Un seul produit par composante, sans
+// FMA : les versions SSE et AVX2 donnent les mêmes flottants que la boucle scalaire.
+void rotateRingScalar(const float* r, std::size_t first, std::size_t n, float c, float s, float* x, float* y) {
+    for (std::size_t j = first; j < n; ++j) {
+        x[j] = r[j] * c;
+        y[j] = r[j] * s;
+    }
+}
 
-    // Étape 2 : top (z=height)
-    for (const auto& p : profile)
-        mesh.vertices.push_back(glm::vec3(p * scaleTop, height));
+#ifdef BEZIER_SIMD_X86
 
-    // Étape 3 : faces latérales
-    for (int i = 0; i < n; ++i) {
-        int next = (i + 1) % n;
+BEZIER_TARGET("sse2")
+void rotateRingSse(const float* r, std::size_t n, float c, float s, float* x, float* y) {
+    const __m128 vc = _mm_set1_ps(c), vs = _mm_set1_ps(s);
+    std::size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        const __m128 v = _mm_loadu_ps(r + j);
+        _mm_storeu_ps(x + j, _mm_mul_ps(v, vc));
+        _mm_storeu_ps(y + j, _mm_mul_ps(v, vs));
+    }
+    rotateRingScalar(r, j, n, c, s, x, y);
+}
 
-        // Triangle 1
-        mesh.indices.push_back(i);
-        mesh.indices.push_back(next);
-        mesh.indices.push_back(n + next);
+BEZIER_TARGET("avx2")
+void rotateRingAvx2(const float* r, std::size_t n, float c, float s, float* x, float* y) {
+    const __m256 vc = _mm256_set1_ps(c), vs = _mm256_set1_ps(s);
+    std::size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m256 v = _mm256_loadu_ps(r + j);
+        _mm256_storeu_ps(x + j, _mm256_mul_ps(v, vc));
+        _mm256_storeu_ps(y + j, _mm256_mul_ps(v, vs));
+    }
+    rotateRingScalar(r, j, n, c, s, x, y);
+}
+
+#endif
+
+void rotateRing(const float* r, std::size_t n, float c, float s, float* x, float* y) {
+#ifdef BEZIER_SIMD_X86
+    static const SimdLevel level = detectSimdLevel();
+    if (level == SimdLevel::AVX2) return rotateRingAvx2(r, n, c, s, x, y);
+    if (level == SimdLevel::SSE) return rotateRingSse(r, n, c, s, x, y);
+#endif
+    rotateRingScalar(r, 0, n, c, s, x, y);
+}
 
-        // Triangle 2
-        mesh.indices.push_back(i);
-        mesh.indices.push_back(n + next);
-        mesh.indices.push_back(n + i);
+glm::vec2 normalizeOrZero(const glm::vec2& v) {
+    const float len = glm::length(v);
+    return (len > 0.0f) ? v / len : glm::vec2(0.0f);
+}
+
+// Tangente unitaire du profil en chaque point : bissectrice des directions des segments
+// voisins non nuls (un seul aux extrémités d'un profil ouvert, on boucle s'il est fermé).
+std::vector<glm::vec2> profileTangents(const std::vector<glm::vec2>& profile, bool closed) {
+    const std::size_t n = profile.size();
+    const std::size_t segments = closed ? n : n - 1;
+    std::vector<glm::vec2> dirs(segments);
+    for (std::size_t k = 0; k < segments; ++k)
+        dirs[k] = normalizeOrZero(profile[(k + 1) % n] - profile[k]);
+
+    // Segment non nul le plus proche avant (incoming) et après (outgoing) chaque point
+    std::vector<glm::vec2> incoming(n, glm::vec2(0.0f)), outgoing(n, glm::vec2(0.0f));
+    const std::size_t passes = closed ? 2 : 1;  // deux tours pour propager par-dessus la jonction
+    glm::vec2 last(0.0f);
+    for (std::size_t pass = 0; pass < passes; ++pass)
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t k = (i + segments - 1) % segments;  // segment qui arrive en i
+            if ((closed || i > 0) && dirs[k] != glm::vec2(0.0f)) last = dirs[k];
+            incoming[i] = last;
+        }
+    last = glm::vec2(0.0f);
+    for (std::size_t pass = 0; pass < passes; ++pass)
+        for (std::size_t i = n; i-- > 0;) {
+            if (i < segments && dirs[i] != glm::vec2(0.0f)) last = dirs[i];
+            outgoing[i] = last;
+        }
+
+    std::vector<glm::vec2> tangents(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const glm::vec2 t = normalizeOrZero(incoming[i] + outgoing[i]);
+        tangents[i] = (t != glm::vec2(0.0f)) ? t : outgoing[i];  // demi-tour : on garde la sortie
     }
+    return tangents;
+}
 
-    // Étape 4 : face inférieure (z=0)
-    for (int i = 1; i < n - 1; ++i) {
-        mesh.indices.push_back(0);
-        mesh.indices.push_back(i);
-        mesh.indices.push_back(i + 1);
+float signedArea(const std::vector<glm::vec2>& polygon) {
+    float area = 0.0f;
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        const glm::vec2& a = polygon[i];
+        const glm::vec2& b = polygon[(i + 1) % polygon.size()];
+        area += a.x * b.y - b.x * a.y;
     }
+    return 0.5f * area;
+}
 
-    // Étape 5 : face supérieure (z=height)
-    for (int i = 1; i < n - 1; ++i) {
-        mesh.indices.push_back(n);
-        mesh.indices.push_back(n + i + 1);
-        mesh.indices.push_back(n + i);
+// Coordonnée u des sommets du profil : longueur de corde cumulée, ramenée à [0, 1]
+// (le segment de fermeture compte dans la longueur totale si le profil est fermé).
+std::vector<float> chordCoordinates(const std::vector<glm::vec2>& profile, bool closed) {
+    const std::size_t n = profile.size();
+    std::vector<float> u(n, 0.0f);
+    for (std::size_t i = 1; i < n; ++i) u[i] = u[i - 1] + glm::distance(profile[i - 1], profile[i]);
+    const float total = u[n - 1] + (closed ? glm::distance(profile[n - 1], profile[0]) : 0.0f);
+    if (total > 0.0f)
+        for (auto& value : u) value /= total;
+    return u;
+}
+
+// Sortie vers Mesh : trois tableaux dimensionnés d'avance à leur taille exacte, UV ignorées
+struct MeshSink {
+    Mesh& mesh;
+    std::size_t cursor = 0;
+
+    MeshSink(Mesh& target, const MeshCounts& counts) : mesh(target) {
+        mesh.vertices.resize(counts.vertices);
+        mesh.normals.resize(counts.vertices);
+        mesh.indices.resize(counts.indices);
     }
 
-    // Étape 6 : Normales
-    mesh.normals.resize(mesh.vertices.size(), glm::vec3(0.0f));
-    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
-        unsigned int i0 = mesh.indices[i];
-        unsigned int i1 = mesh.indices[i + 1];
-        unsigned int i2 = mesh.indices[i + 2];
+    bool wantsNormals() const { return true; }
+    bool wantsUV() const { return false; }
+    bool wantsStrips() const { return false; }  // Mesh::indices est lu comme une liste de triangles
 
-        glm::vec3 v0 = mesh.vertices[i0];
-        glm::vec3 v1 = mesh.vertices[i1];
-        glm::vec3 v2 = mesh.vertices[i2];
+    void vertex(std::size_t i, const glm::vec3& position, const glm::vec3& normal, const glm::vec2&) {
+        mesh.vertices[i] = position;
+        mesh.normals[i] = normal;
+    }
 
-        glm::vec3 normal = glm::normalize(glm::cross(v1 - v0, v2 - v0));
+    void triangle(unsigned int a, unsigned int b, unsigned int c) {
+        triangleAt(cursor / 3, a, b, c);
+        cursor += 3;
+    }
 
-        mesh.normals[i0] += normal;
-        mesh.normals[i1] += normal;
-        mesh.normals[i2] += normal;
+    void triangleAt(std::size_t t, unsigned int a, unsigned int b, unsigned int c) {
+        mesh.indices[3 * t] = a;
+        mesh.indices[3 * t + 1] = b;
+        mesh.indices[3 * t + 2] = c;
     }
 
-    for (auto& n : mesh.normals)
-        n = glm::normalize(n);
+    void indexAt(std::size_t k, unsigned int value) { mesh.indices[k] = value; }
+    void restartAt(std::size_t k) { mesh.indices[k] = 0xFFFFFFFFu; }
+};
+
+// Les générateurs écrivent dans un Sink (MeshSink ou MeshBuilder) qui expose vertex(i, ...),
+// triangle(a, b, c) et triangleAt(t, a, b, c), plus indexAt / restartAt pour les grilles émises
+// en bandes ; l'appelant l'a dimensionné avec les comptes exacts ci-dessous. Écrire à des indices distincts depuis plusieurs threads est sûr.
+
+// Normales analytiques : la face latérale X(u, v) = (1 + v (s - 1)) p(u) + v h z a pour normale
+// ∂u × ∂v ∝ (h p'.y, -h p'.x, (s - 1)(p'.x p.y - p'.y p.x)), identique en bas et en haut.
+// Les couvercles ont leurs propres sommets et une normale plate ; l'enroulement suit le sens
+// du profil pour que faces et normales pointent vers l'extérieur. Tout ce qui ne dépend que du
+// profil est calculé une fois ici ; hauteur et échelle n'interviennent qu'à l'écriture.
+LinearProfile prepareLinear(const std::vector<glm::vec2>& profile, bool wantsUV) {
+    LinearProfile data;
+    data.points = profile;
+    data.tangents = profileTangents(profile, true);
+    data.orientation = (signedArea(profile) >= 0.0f) ? 1.0f : -1.0f;
+
+    // UV : abscisse curviligne × hauteur sur les côtés, boîte englobante sur les couvercles
+    if (wantsUV) {
+        data.u = chordCoordinates(profile, true);
+        glm::vec2 lo = profile[0], hi = profile[0];
+        for (const auto& p : profile) { lo = glm::min(lo, p); hi = glm::max(hi, p); }
+        data.capLow = lo;
+        data.capExtent = glm::max(hi - lo, glm::vec2(1e-12f));
+    }
+    return data;
+}
 
-    return mesh;
+// Étape 1 : base (z=0) puis top (z=height) des faces latérales. La normale dépend de la hauteur
+// et de l'échelle : un changement de paramètre réécrit aussi la base, sauf sans normales.
+template <typename Sink>
+void emitLinearSides(Sink& out, const LinearProfile& data, float height, float scaleTop, bool base, bool top,
+                     ThreadPool& pool) {
+    const std::vector<glm::vec2>& profile = data.points;
+    const std::size_t n = profile.size();
+    forEachRange(pool, n, 2, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const glm::vec2& p = profile[i];
+            const glm::vec2& t = data.tangents[i];
+            const glm::vec3 normal(height * t.y, -height * t.x, (scaleTop - 1.0f) * (t.x * p.y - t.y * p.x));
+            const float len = glm::length(normal);
+            const glm::vec3 unit = len > 0.0f ? normal * (data.orientation / len) : glm::vec3(0.0f);
+            const float u = out.wantsUV() ? data.u[i] : 0.0f;
+            if (base) out.vertex(i, glm::vec3(p, 0.0f), unit, glm::vec2(u, 0.0f));
+            if (top) out.vertex(n + i, glm::vec3(p * scaleTop, height), unit, glm::vec2(u, out.wantsUV() ? 1.0f : 0.0f));
+        }
+    });
 }
 
-Mesh extrudeRevolution(const std::vector<glm::vec2>& profile, int slices = 36) {
-    Mesh mesh;
-    int n = profile.size();
-    if (n < 2) return mesh;
+// Étape 2 : sommets des couvercles, normales plates
+template <typename Sink>
+void emitLinearCaps(Sink& out, const LinearProfile& data, float height, float scaleTop, bool bottom, bool top,
+                    ThreadPool& pool) {
+    const std::vector<glm::vec2>& profile = data.points;
+    const std::size_t n = profile.size();
+    forEachRange(pool, n, 2, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const glm::vec2& p = profile[i];
+            const glm::vec2 uv = out.wantsUV() ? (p - data.capLow) / data.capExtent : glm::vec2(0.0f);
+            if (bottom) out.vertex(2 * n + i, glm::vec3(p, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), uv);
+            if (top) out.vertex(3 * n + i, glm::vec3(p * scaleTop, height), glm::vec3(0.0f, 0.0f, 1.0f), uv);
+        }
+    });
+}
 
-    // Étape 1 : Générer les vertex
-    for (int i = 0; i <= slices; ++i) {
-        float theta = (float)i / slices * 2.0f * pi;
-        float c = cos(theta);
-        float s = sin(theta);
-        for (const auto& p : profile) {
-            glm::vec3 rotated(p.x * c, p.x * s, p.y);  // On tourne autour de l'axe Z
-            mesh.vertices.push_back(rotated);
+// Les faces ne dépendent que du nombre de points et du sens du profil
+template <typename Sink>
+void emitLinearFaces(Sink& out, int n, float orientation) {
+    auto triangle = [&](int a, int b, int c) {
+        if (orientation > 0.0f) out.triangle(a, b, c);
+        else out.triangle(a, c, b);
+    };
+
+    // Étape 3 : faces latérales
+    for (int i = 0; i < n; ++i) {
+        int next = (i + 1) % n;
+        triangle(i, next, n + next);
+        triangle(i, n + next, n + i);
+    }
+
+    // Étape 4 : face inférieure (z=0), vue de dessous
+    const int bottom = 2 * n, top = 3 * n;
+    for (int i = 1; i < n - 1; ++i)
+        triangle(bottom, bottom + i + 1, bottom + i);
+
+    // Étape 5 : face supérieure (z=height)
+    for (int i = 1; i < n - 1; ++i)
+        triangle(top, top + i, top + i + 1);
+}
+
+template <typename Sink>
+void emitLinear(Sink& out, const LinearProfile& data, float height, float scaleTop, ThreadPool& pool) {
+    emitLinearSides(out, data, height, scaleTop, true, true, pool);
+    emitLinearCaps(out, data, height, scaleTop, true, true, pool);
+    emitLinearFaces(out, (int)data.points.size(), data.orientation);
+}
+
+// Normales analytiques : en (r, z) = p(u) tourné de θ, la normale vaut
+// sign(r) (z' cos θ, z' sin θ, -r'), orientée comme les faces. La couture (θ = 2π) reçoit
+// exactement les normales de θ = 0 ; sur l'axe (r = 0), le signe vient du point voisin.
+RevolutionProfile prepareRevolution(const std::vector<glm::vec2>& profile, bool wantsNormals, bool wantsUV) {
+    RevolutionProfile data;
+    data.points = profile;
+    const int n = profile.size();
+
+    float extent = 0.0f;
+    for (const auto& p : profile) extent = std::max(extent, std::max(std::abs(p.x), std::abs(p.y)));
+    const bool closed = n > 2 && glm::distance(profile.front(), profile.back()) <= 1e-6f * extent;
+
+    // Rayons du profil et de sa normale dans le demi-plan (r, z), tournés ensuite avec l'anneau
+    data.radius.resize(n);
+    for (int j = 0; j < n; ++j) data.radius[j] = profile[j].x;
+    if (wantsNormals) {
+        const std::vector<glm::vec2> tangents = profileTangents(profile, closed);
+        data.planeNormals.resize(n);
+        data.normalRadius.resize(n);
+        float side = 0.0f;
+        for (int j = 0; j < n && side == 0.0f; ++j) side = (profile[j].x > 0.0f) ? 1.0f : (profile[j].x < 0.0f ? -1.0f : 0.0f);
+        for (int j = 0; j < n; ++j) {
+            if (profile[j].x != 0.0f) side = (profile[j].x > 0.0f) ? 1.0f : -1.0f;
+            data.planeNormals[j] = side * glm::vec2(tangents[j].y, -tangents[j].x);
+            data.normalRadius[j] = data.planeNormals[j].x;
         }
     }
+    // UV : abscisse curviligne le long du profil, angle le long de la révolution
+    if (wantsUV) data.u = chordCoordinates(profile, false);
+    return data;
+}
+
+// Les anneaux sont indépendants : chacun tourne le profil avec son entrée de la table des
+// angles et écrit ses sommets et ses faces à leur place.
+template <typename Sink>
+void emitRevolution(Sink& out, const RevolutionProfile& data, int slices, ThreadPool& pool) {
+    const std::vector<glm::vec2>& profile = data.points;
+    const int n = profile.size();
 
-    // Étape 2 : Générer les faces
-    int ring = n;
+    // Table des angles ; la couture (i = slices) reprend l'angle 0
+    std::vector<float> cosTable(slices), sinTable(slices);
     for (int i = 0; i < slices; ++i) {
-        for (int j = 0; j < n - 1; ++j) {
-            int curr = i * ring + j;
-            int next = (i + 1) * ring + j;
+        float theta = (float)i / slices * 2.0f * pi;
+        cosTable[i] = cos(theta);
+        sinTable[i] = sin(theta);
+    }
 
-            mesh.indices.push_back(curr);
-            mesh.indices.push_back(next);
-            mesh.indices.push_back(curr + 1);
+    forEachRange(pool, slices + 1, n, [&](std::size_t first, std::size_t last) {
+        thread_local std::vector<float> scratch;
+        scratch.resize(4 * n);
+        float* x = scratch.data();
+        float* y = x + n;
+        float* nx = y + n;
+        float* ny = nx + n;
+        for (int i = (int)first; i < (int)last; ++i) {
+            const float c = cosTable[i % slices];
+            const float s = sinTable[i % slices];
+            const float v = (float)i / slices;
+
+            // Étape 1 : sommets de l'anneau, tournés autour de l'axe Z
+            rotateRing(data.radius.data(), n, c, s, x, y);
+            if (out.wantsNormals()) rotateRing(data.normalRadius.data(), n, c, s, nx, ny);
+            for (int j = 0; j < n; ++j) {
+                const glm::vec3 normal = out.wantsNormals() ? glm::vec3(nx[j], ny[j], data.planeNormals[j].y) : glm::vec3(0.0f);
+                out.vertex(i * n + j, glm::vec3(x[j], y[j], profile[j].y), normal,
+                           out.wantsUV() ? glm::vec2(data.u[j], v) : glm::vec2(0.0f));
+            }
+
+            // Étape 2 : faces entre cet anneau et le suivant, en une bande (curr, next, curr + 1,
+            // next + 1, ...) ou en triangles séparés
+            if (i == slices) continue;
+            if (out.wantsStrips()) {
+                const std::size_t base = (std::size_t)i * (2 * n + 1);
+                for (int j = 0; j < n; ++j) {
+                    out.indexAt(base + 2 * j, i * n + j);
+                    out.indexAt(base + 2 * j + 1, (i + 1) * n + j);
+                }
+                if (i + 1 < slices) out.restartAt(base + 2 * n);
+                continue;
+            }
+            for (int j = 0; j < n - 1; ++j) {
+                int curr = i * n + j;
+                int next = (i + 1) * n + j;
+                const std::size_t slot = 2 * ((std::size_t)i * (n - 1) + j);
+                out.triangleAt(slot, curr, next, curr + 1);
+                out.triangleAt(slot + 1, curr + 1, next, next + 1);
+            }
+        }
+    });
+}
 
-            mesh.indices.push_back(curr + 1);
-            mesh.indices.push_back(next);
-            mesh.indices.push_back(next + 1);
+// Positions de la grille (profil × chemin), sommet i * profileSize + j. Seuls les anneaux
+// [ringFirst, ringLast) sont écrits, et parmi eux les colonnes marquées dans columns (toutes si
+// columns est vide) ; les anneaux sont répartis entre les threads comme pour la révolution.
+void sweepPositions(std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& profile, const SweepFrames& sweep,
+                    std::size_t ringFirst, std::size_t ringLast, const std::vector<char>& columns, ThreadPool& pool) {
+    const std::size_t profileSize = profile.size();
+    const std::vector<glm::vec3>& path = sweep.path();
+    const std::vector<glm::mat3>& frames = sweep.frames();
+    positions.resize(path.size() * profileSize);
+
+    forEachRange(pool, ringLast - ringFirst, profileSize, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = ringFirst + first; i < ringFirst + last; ++i)
+            for (std::size_t j = 0; j < profileSize; ++j)
+                if (columns.empty() || columns[j])
+                    positions[i * profileSize + j] = path[i] + frames[i] * glm::vec3(profile[j], 0.0f);
+    });
+}
+
+// Écrit les sommets [ringFirst, ringLast) × columns de la grille depuis positions et normals ;
+// les UV suivent u sur le profil et l'avancée le long du chemin.
+template <typename Sink>
+void emitSweepVertices(Sink& out, const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals,
+                       const std::vector<float>& u, std::size_t profileSize, std::size_t pathSize,
+                       std::size_t ringFirst, std::size_t ringLast, const std::vector<char>& columns, ThreadPool& pool) {
+    forEachRange(pool, ringLast - ringFirst, profileSize, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = ringFirst + first; i < ringFirst + last; ++i) {
+            const float v = (float)i / (pathSize - 1);
+            for (std::size_t j = 0; j < profileSize; ++j) {
+                if (!columns.empty() && !columns[j]) continue;
+                const std::size_t k = i * profileSize + j;
+                out.vertex(k, positions[k], out.wantsNormals() ? normals[k] : glm::vec3(0.0f),
+                           out.wantsUV() ? glm::vec2(u[j], v) : glm::vec2(0.0f));
+            }
         }
+    });
+}
+
+// Les faces ne dépendent que des tailles du profil et du chemin. En bandes, une bande par
+// colonne j suit le chemin : (i, j), (i, j + 1), (i + 1, j), ... donne les mêmes triangles,
+// avec le même enroulement, que la liste (curr, curr_next, next), (next, curr_next, next_next).
+template <typename Sink>
+void emitSweepFaces(Sink& out, std::size_t profileSize, std::size_t pathSize, ThreadPool& pool) {
+    if (out.wantsStrips()) {
+        forEachRange(pool, profileSize, pathSize, [&](std::size_t first, std::size_t last) {
+            for (size_t j = first; j < last; ++j) {
+                const std::size_t base = j * (2 * pathSize + 1);
+                const size_t next_j = (j + 1) % profileSize;
+                for (size_t i = 0; i < pathSize; ++i) {
+                    out.indexAt(base + 2 * i, i * profileSize + j);
+                    out.indexAt(base + 2 * i + 1, i * profileSize + next_j);
+                }
+                if (j + 1 < profileSize) out.restartAt(base + 2 * pathSize);
+            }
+        });
+        return;
     }
+    forEachRange(pool, pathSize - 1, profileSize, [&](std::size_t first, std::size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            for (size_t j = 0; j < profileSize; ++j) {
+                int curr = i * profileSize + j;
+                int next = curr + profileSize;
+                int next_j = (j + 1) % profileSize;
+                int curr_next = i * profileSize + next_j;
+                int next_next = curr_next + profileSize;
+
+                const std::size_t slot = 2 * (i * profileSize + j);
+                out.triangleAt(slot, curr, curr_next, next);
+                out.triangleAt(slot + 1, next, curr_next, next_next);
+            }
+        }
+    });
+}
+
+// Triangles seuls, en liste, pour computeVertexNormals
+struct TriangleSink {
+    std::vector<unsigned int>& indices;
 
-    // Étape 3 : Normales (comme d’habitude)
-    mesh.normals.resize(mesh.vertices.size(), glm::vec3(0.0f));
-    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
-        auto i0 = mesh.indices[i], i1 = mesh.indices[i+1], i2 = mesh.indices[i+2];
-        glm::vec3 v0 = mesh.vertices[i0], v1 = mesh.vertices[i1], v2 = mesh.vertices[i2];
-        glm::vec3 n = glm::normalize(glm::cross(v1 - v0, v2 - v0));
-        mesh.normals[i0] += n;
-        mesh.normals[i1] += n;
-        mesh.normals[i2] += n;
+    bool wantsStrips() const { return false; }
+    void triangleAt(std::size_t t, unsigned int a, unsigned int b, unsigned int c) {
+        indices[3 * t] = a;
+        indices[3 * t + 1] = b;
+        indices[3 * t + 2] = c;
     }
-    for (auto& n : mesh.normals) n = glm::normalize(n);
+    void indexAt(std::size_t k, unsigned int value) { indices[k] = value; }
+    void restartAt(std::size_t) {}
+};
+
+// Normales de toute la grille : moyenne des faces adjacentes par le calcul partagé de
+// Mesh::computeNormals (parallèle, SIMD), sur la liste de triangles d'emitSweepFaces, construite
+// si triangles est vide et gardée sinon (elle ne dépend que des tailles)
+void sweepNormals(const std::vector<glm::vec3>& positions, std::vector<unsigned int>& triangles,
+                  std::vector<glm::vec3>& normals, std::size_t profileSize, std::size_t pathSize, ThreadPool& pool) {
+    if (triangles.empty()) {
+        triangles.resize(6 * (pathSize - 1) * profileSize);
+        TriangleSink sink{triangles};
+        emitSweepFaces(sink, profileSize, pathSize, pool);
+    }
+    computeVertexNormals(positions, triangles, normals, NormalWeighting::Uniform, NormalMethod::Simd, pool);
+}
+
+template <typename Sink>
+void emitGeneralized(Sink& out, const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path, ThreadPool& pool) {
+    SweepFrames sweep;
+    sweep.update(path);
+    const std::vector<float> u = out.wantsUV() ? chordCoordinates(profile, true) : std::vector<float>();
+    std::vector<glm::vec3> positions, normals;
+    std::vector<unsigned int> triangles;
+    sweepPositions(positions, profile, sweep, 0, path.size(), std::vector<char>(), pool);
+    if (out.wantsNormals()) sweepNormals(positions, triangles, normals, profile.size(), path.size(), pool);
+    emitSweepVertices(out, positions, normals, u, profile.size(), path.size(), 0, path.size(), std::vector<char>(), pool);
+    emitSweepFaces(out, profile.size(), path.size(), pool);
+}
+}
+
+MeshCounts linearCounts(std::size_t profileSize) {
+    if (profileSize < 3) return MeshCounts();  // au moins un polygone
+    const std::size_t triangles = 6 * profileSize + 6 * (profileSize - 2);
+    return MeshCounts{4 * profileSize, triangles, triangles};  // couvercles en éventail : pas de bandes
+}
+
+MeshCounts revolutionCounts(std::size_t profileSize, int slices) {
+    if (profileSize < 2 || slices < 1) return MeshCounts();
+    return MeshCounts{(slices + 1) * profileSize, 6 * slices * (profileSize - 1), slices * (2 * profileSize + 1) - 1};
+}
+
+MeshCounts generalizedCounts(std::size_t profileSize, std::size_t pathSize) {
+    if (profileSize == 0 || pathSize < 2) return MeshCounts();
+    return MeshCounts{pathSize * profileSize, 6 * (pathSize - 1) * profileSize, profileSize * (2 * pathSize + 1) - 1};
+}
 
+Mesh extrudeLinear(const std::vector<glm::vec2>& profile, float height, float scaleTop, ThreadPool& pool) {
+    Mesh mesh;
+    const MeshCounts counts = linearCounts(profile.size());
+    if (counts.vertices == 0) return mesh;
+    MeshSink sink(mesh, counts);
+    emitLinear(sink, prepareLinear(profile, false), height, scaleTop, pool);
     return mesh;
 }
-Mesh extrudeGeneralized(const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path) {
+
+Mesh extrudeRevolution(const std::vector<glm::vec2>& profile, int slices, ThreadPool& pool) {
     Mesh mesh;
-    if (profile.empty() || path.size() < 2) return mesh;
-
-    size_t profileSize = profile.size();
-    size_t pathSize = path.size();
-
-    // Génération des sommets
-    for (size_t i = 0; i < pathSize; ++i) {
-        glm::vec3 tangent;
-        if (i < pathSize - 1)
-            tangent = glm::normalize(path[i + 1] - path[i]);
-        else
-            tangent = glm::normalize(path[i] - path[i - 1]);
-
-        // Orthonormal basis
-        glm::vec3 up(0.0f, 1.0f, 0.0f);
-        if (glm::abs(glm::dot(tangent, up)) > 0.99f) {
-            up = glm::vec3(1.0f, 0.0f, 0.0f); // éviter colinéarité
+    const MeshCounts counts = revolutionCounts(profile.size(), slices);
+    if (counts.vertices == 0) return mesh;
+    MeshSink sink(mesh, counts);
+    emitRevolution(sink, prepareRevolution(profile, true, false), slices, pool);
+    return mesh;
+}
+
+Mesh extrudeGeneralized(const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path, ThreadPool& pool) {
+    Mesh mesh;
+    const MeshCounts counts = generalizedCounts(profile.size(), path.size());
+    if (counts.vertices == 0) return mesh;
+    MeshSink sink(mesh, counts);
+    emitGeneralized(sink, profile, path, pool);
+    return mesh;
+}
+
+InterleavedMesh buildLinear(const std::vector<glm::vec2>& profile, float height, float scaleTop, VertexFormat format,
+                            ThreadPool& pool) {
+    const MeshCounts counts = linearCounts(profile.size());
+    MeshBuilder builder(format, counts.vertices, counts.indices);
+    if (counts.vertices != 0)
+        emitLinear(builder, prepareLinear(profile, builder.wantsUV()), height, scaleTop, pool);
+    return builder.finish();
+}
+
+InterleavedMesh buildRevolution(const std::vector<glm::vec2>& profile, int slices, VertexFormat format, ThreadPool& pool) {
+    const MeshCounts counts = revolutionCounts(profile.size(), slices);
+    MeshBuilder builder(format, counts.vertices, counts.stripIndices, Primitive::TriangleStrip);
+    if (counts.vertices != 0)
+        emitRevolution(builder, prepareRevolution(profile, builder.wantsNormals(), builder.wantsUV()), slices, pool);
+    return builder.finish();
+}
+
+InterleavedMesh buildGeneralized(const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path, VertexFormat format,
+                                 ThreadPool& pool) {
+    const MeshCounts counts = generalizedCounts(profile.size(), path.size());
+    MeshBuilder builder(format, counts.vertices, counts.stripIndices, Primitive::TriangleStrip);
+    if (counts.vertices != 0) emitGeneralized(builder, profile, path, pool);
+    return builder.finish();
+}
+
+Mesh extrudeLinear(const BezierCurveData& profile, const SamplingOptions& sampling, float height, float scaleTop) {
+    return extrudeLinear(profile.sampled(sampling), height, scaleTop);
+}
+
+Mesh extrudeRevolution(const BezierCurveData& profile, const SamplingOptions& sampling, int steps) {
+    return extrudeRevolution(profile.sampled(sampling), steps);
+}
+
+Mesh extrudeGeneralized(const BezierCurveData& profile, const SamplingOptions& sampling, const std::vector<glm::vec3>& path3D) {
+    return extrudeGeneralized(profile.sampled(sampling), path3D);
+}
+
+Mesh extrudeLinear(const BSplineCurve& profile, const SamplingOptions& sampling, float height, float scaleTop) {
+    return extrudeLinear(profile.sampled(sampling), height, scaleTop);
+}
+
+Mesh extrudeRevolution(const BSplineCurve& profile, const SamplingOptions& sampling, int steps) {
+    return extrudeRevolution(profile.sampled(sampling), steps);
+}
+
+Mesh extrudeGeneralized(const BSplineCurve& profile, const SamplingOptions& sampling, const std::vector<glm::vec3>& path3D) {
+    return extrudeGeneralized(profile.sampled(sampling), path3D);
+}
+
+const InterleavedMesh& SweepExtrusion::update(const std::vector<glm::vec2>& profile, const std::vector<glm::vec3>& path,
+                                              ThreadPool& pool) {
+    const bool pathChanged = sweep.update(path);
+    const MeshCounts counts = generalizedCounts(profile.size(), path.size());
+    const bool wantsUV = InterleavedMesh::hasUV(vertexFormat);
+    const bool wantsNormals = InterleavedMesh::hasNormals(vertexFormat);
+    std::vector<float> u = wantsUV && !profile.empty() ? chordCoordinates(profile, true) : std::vector<float>();
+    const std::size_t profileSize = profile.size(), pathSize = path.size();
+
+    const bool rebuild = counts.vertices == 0 || result.empty() || result.format != vertexFormat ||
+                         profileSize != sweptProfile.size() || pathSize != sweptPathSize;
+    if (rebuild) {
+        MeshBuilder builder(vertexFormat, counts.vertices, counts.stripIndices, Primitive::TriangleStrip);
+        triangles.clear();
+        if (counts.vertices != 0) {
+            sweepPositions(positions, profile, sweep, 0, pathSize, std::vector<char>(), pool);
+            if (wantsNormals) sweepNormals(positions, triangles, normals, profileSize, pathSize, pool);
+            emitSweepVertices(builder, positions, normals, u, profileSize, pathSize, 0, pathSize, std::vector<char>(), pool);
+            emitSweepFaces(builder, profileSize, pathSize, pool);
+        }
+        result = builder.finish();
+        rewritten = counts.vertices;
+    } else {
+        // Colonnes touchées par le profil : le point déplacé et ses deux voisins (normales) ;
+        // la coordonnée u peut en plus changer partout quand la longueur du profil change
+        std::vector<char> columns(profileSize, 0);
+        bool profileChanged = false;
+        for (std::size_t j = 0; j < profileSize; ++j) {
+            if (profile[j] != sweptProfile[j]) {
+                columns[(j + profileSize - 1) % profileSize] = columns[j] = columns[(j + 1) % profileSize] = 1;
+                profileChanged = true;
+            } else if (wantsUV && u[j] != profileU[j]) {
+                columns[j] = 1;
+                profileChanged = true;
+            }
         }
-        glm::vec3 side = glm::normalize(glm::cross(up, tangent));
-        glm::vec3 normal = glm::normalize(glm::cross(tangent, side));
 
-        glm::mat3 frame(side, normal, tangent); // colonne = axes
+        // Sommets touchés : anneaux dont le repère ou le point a changé et leurs voisins, puis,
+        // dans les autres anneaux, les colonnes marquées (les anneaux entiers ne sont pas repris)
+        std::size_t ringFirst = 0, ringLast = 0;
+        if (pathChanged) {
+            ringFirst = std::max<std::size_t>(sweep.changedBegin(), 1) - 1;
+            ringLast = std::min(sweep.changedEnd() + 1, pathSize);
+        }
+        const std::vector<char> allColumns;
+        auto forEachPart = [&](const auto& fn) {
+            if (pathChanged) fn(ringFirst, ringLast, allColumns);
+            if (profileChanged) {
+                fn(std::size_t(0), ringFirst, columns);
+                fn(ringLast, pathSize, columns);
+            }
+        };
+
+        forEachPart([&](std::size_t first, std::size_t last, const std::vector<char>& cols) {
+            sweepPositions(positions, profile, sweep, first, last, cols, pool);
+        });
+        // Les normales sont recalculées sur toute la grille ; celles des sommets non réécrits ne
+        // dépendent que de positions inchangées et retrouvent exactement leur valeur
+        if (wantsNormals && (pathChanged || profileChanged))
+            sweepNormals(positions, triangles, normals, profileSize, pathSize, pool);
+
+        MeshBuilder builder(std::move(result));
+        rewritten = 0;
+        forEachPart([&](std::size_t first, std::size_t last, const std::vector<char>& cols) {
+            emitSweepVertices(builder, positions, normals, u, profileSize, pathSize, first, last, cols, pool);
+        });
+        if (pathChanged) rewritten += (ringLast - ringFirst) * profileSize;
+        if (profileChanged) {
+            std::size_t marked = 0;
+            for (char c : columns) marked += c;
+            rewritten += marked * (pathSize - (ringLast - ringFirst));
+        }
+        result = builder.finish();
+    }
 
-        for (const auto& p : profile) {
-            glm::vec3 local(p.x, p.y, 0.0f);
-            glm::vec3 worldPos = path[i] + frame * local;
-            mesh.vertices.push_back(worldPos);
+    sweptProfile = profile;
+    profileU = std::move(u);
+    sweptPathSize = pathSize;
+    return result;
+}
+
+const InterleavedMesh& LinearExtrusion::update(const std::vector<glm::vec2>& profile, float height, float scaleTop,
+                                               ThreadPool& pool) {
+    if (profile != data.points || result.format != vertexFormat) {
+        if (linearCounts(profile.size()).vertices != 0) {
+            data = prepareLinear(profile, InterleavedMesh::hasUV(vertexFormat));
+        } else {
+            data = LinearProfile();
+            data.points = profile;
         }
+        rebuild(height, scaleTop, pool);
+        return result;
     }
+    return update(height, scaleTop, pool);
+}
 
-    // Génération des indices
-    for (size_t i = 0; i < pathSize - 1; ++i) {
-        for (size_t j = 0; j < profileSize; ++j) {
-            int curr = i * profileSize + j;
-            int next = curr + profileSize;
-            int next_j = (j + 1) % profileSize;
-            int curr_next = i * profileSize + next_j;
-            int next_next = curr_next + profileSize;
+const InterleavedMesh& LinearExtrusion::update(float height, float scaleTop, ThreadPool& pool) {
+    if (result.format != vertexFormat) return update(std::vector<glm::vec2>(data.points), height, scaleTop, pool);
+    rewritten = 0;
+    if (height == builtHeight && scaleTop == builtScale) return result;
+    if (!result.empty()) {
+        // Seuls l'anneau du haut et son couvercle bougent ; la base ne change que par sa normale
+        const bool normals = InterleavedMesh::hasNormals(vertexFormat);
+        MeshBuilder builder(std::move(result));
+        emitLinearSides(builder, data, height, scaleTop, normals, true, pool);
+        emitLinearCaps(builder, data, height, scaleTop, false, true, pool);
+        result = builder.finish();
+        rewritten = (normals ? 3 : 2) * data.points.size();
+    }
+    builtHeight = height;
+    builtScale = scaleTop;
+    return result;
+}
 
-            mesh.indices.push_back(curr);
-            mesh.indices.push_back(curr_next);
-            mesh.indices.push_back(next);
+void LinearExtrusion::rebuild(float height, float scaleTop, ThreadPool& pool) {
+    const MeshCounts counts = linearCounts(data.points.size());
+    MeshBuilder builder(std::move(result), vertexFormat, counts.vertices, counts.indices);
+    if (counts.vertices != 0) emitLinear(builder, data, height, scaleTop, pool);
+    result = builder.finish();
+    rewritten = counts.vertices;
+    builtHeight = height;
+    builtScale = scaleTop;
+}
 
-            mesh.indices.push_back(next);
-            mesh.indices.push_back(curr_next);
-            mesh.indices.push_back(next_next);
-        }
+const InterleavedMesh& RevolutionExtrusion::update(const std::vector<glm::vec2>& profile, int slices, ThreadPool& pool) {
+    if (profile != data.points || result.format != vertexFormat) {
+        data = prepareRevolution(profile, InterleavedMesh::hasNormals(vertexFormat), InterleavedMesh::hasUV(vertexFormat));
+        rebuild(slices, pool);
+        return result;
     }
+    return update(slices, pool);
+}
 
-    // Calculs des normales
-    mesh.computeNormals();
-    return mesh;
+const InterleavedMesh& RevolutionExtrusion::update(int slices, ThreadPool& pool) {
+    if (result.format != vertexFormat) return update(std::vector<glm::vec2>(data.points), slices, pool);
+    rewritten = 0;
+    if (slices != builtSlices) rebuild(slices, pool);
+    return result;
+}
+
+// Chaque angle change avec le nombre de tranches : tous les anneaux sont réécrits, mais les
+// données du profil sont réutilisées et le tampon garde sa mémoire
+void RevolutionExtrusion::rebuild(int slices, ThreadPool& pool) {
+    const MeshCounts counts = revolutionCounts(data.points.size(), slices);
+    MeshBuilder builder(std::move(result), vertexFormat, counts.vertices, counts.stripIndices,
+                        Primitive::TriangleStrip);
+    if (counts.vertices != 0) emitRevolution(builder, data, slices, pool);
+    result = builder.finish();
+    rewritten = counts.vertices;
+    builtSlices = slices;
 }
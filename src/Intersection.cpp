@@ -0,0 +1,247 @@
+#include "Intersection.hpp"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace {
+
+struct Box {
+    glm::dvec2 min, max;
+};
+
+Box boundsOf(const glm::dvec2* pts, std::size_t n) {
+    Box b{pts[0], pts[0]};
+    for (std::size_t i = 1; i < n; ++i) {
+        b.min = glm::min(b.min, pts[i]);
+        b.max = glm::max(b.max, pts[i]);
+    }
+    return b;
+}
+
+bool overlaps(const Box& a, const Box& b, double margin) {
+    return a.min.x <= b.max.x + margin && b.min.x <= a.max.x + margin &&
+           a.min.y <= b.max.y + margin && b.min.y <= a.max.y + margin;
+}
+
+double distanceToLine(const glm::dvec2& p, const glm::dvec2& a, const glm::dvec2& b) {
+    const glm::dvec2 ab = b - a;
+    const double len2 = glm::dot(ab, ab);
+    const double u = (len2 > 0.0) ? glm::clamp(glm::dot(p - a, ab) / len2, 0.0, 1.0) : 0.0;
+    return glm::length(p - (a + u * ab));
+}
+
+bool isFlat(const glm::dvec2* pts, std::size_t n, double tolerance) {
+    for (std::size_t i = 1; i + 1 < n; ++i)
+        if (distanceToLine(pts[i], pts[0], pts[n - 1]) > tolerance) return false;
+    return true;
+}
+
+void splitHalf(const glm::dvec2* pts, std::size_t n, glm::dvec2* left, glm::dvec2* right, glm::dvec2* temp) {
+    std::copy(pts, pts + n, temp);
+    for (std::size_t level = 0; level < n; ++level) {
+        left[level] = temp[0];
+        right[n - 1 - level] = temp[n - 1 - level];
+        for (std::size_t i = 0; i + 1 < n - level; ++i)
+            temp[i] = 0.5 * (temp[i] + temp[i + 1]);
+    }
+}
+
+// Intersection des segments [p, p + r] et [q, q + s] ; u et v paramètres locaux dans [0, 1]
+bool segmentIntersection(const glm::dvec2& p, const glm::dvec2& r, const glm::dvec2& q, const glm::dvec2& s,
+                         double& u, double& v) {
+    const double denom = r.x * s.y - r.y * s.x;
+    if (std::abs(denom) < 1e-300) return false;  // parallèles ou colinéaires : ignorés
+    const glm::dvec2 qp = q - p;
+    u = (qp.x * s.y - qp.y * s.x) / denom;
+    v = (qp.x * r.y - qp.y * r.x) / denom;
+    const double eps = 1e-9;
+    return u >= -eps && u <= 1.0 + eps && v >= -eps && v <= 1.0 + eps;
+}
+
+glm::dvec2 evaluateAt(const std::vector<glm::dvec2>& cp, std::vector<glm::dvec2>& temp, double t) {
+    temp.assign(cp.begin(), cp.end());
+    return BezierCurve2d::deCasteljauInPlace(temp.data(), temp.size(), t);
+}
+
+// Le point trouvé sur les cordes est juste à la tolérance près, mais le paramètre linéaire sur la
+// corde ne suit pas la vitesse de la courbe : quelques itérations de Newton sur A(s) - B(t) = 0.
+void refineParameters(const std::vector<glm::dvec2>& a, const std::vector<glm::dvec2>& da,
+                      const std::vector<glm::dvec2>& b, const std::vector<glm::dvec2>& db,
+                      std::vector<glm::dvec2>& temp, double& s, double& t) {
+    glm::dvec2 residual = evaluateAt(a, temp, s) - evaluateAt(b, temp, t);
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        const glm::dvec2 ta = evaluateAt(da, temp, s), tb = evaluateAt(db, temp, t);
+        const double det = -ta.x * tb.y + ta.y * tb.x;
+        if (std::abs(det) < 1e-12) return;  // tangence : on garde l'estimation des cordes
+        const double ns = glm::clamp(s - (-tb.y * residual.x + tb.x * residual.y) / det, 0.0, 1.0);
+        const double nt = glm::clamp(t - (-ta.y * residual.x + ta.x * residual.y) / det, 0.0, 1.0);
+        const glm::dvec2 next = evaluateAt(a, temp, ns) - evaluateAt(b, temp, nt);
+        if (glm::dot(next, next) >= glm::dot(residual, residual)) return;
+        s = ns;
+        t = nt;
+        residual = next;
+    }
+}
+
+std::vector<glm::dvec2> derivativePoints(const std::vector<glm::dvec2>& cp) {
+    std::vector<glm::dvec2> d(cp.size() - 1);
+    const double degree = static_cast<double>(cp.size() - 1);
+    for (std::size_t i = 0; i + 1 < cp.size(); ++i) d[i] = degree * (cp[i + 1] - cp[i]);
+    return d;
+}
+
+// Paire de morceaux en attente : intervalles de paramètres et points de contrôle dans la pile
+struct Frame {
+    double a0, a1, b0, b1;
+    int depth;
+};
+
+}
+
+void intersectCurves(const BezierCurveData& a, const BezierCurveData& b, std::vector<CurveIntersection>& out,
+                     const IntersectionOptions& options, int indexA, int indexB) {
+    const std::vector<glm::vec2>& worldA = a.worldControlPoints();
+    const std::vector<glm::vec2>& worldB = b.worldControlPoints();
+    const std::size_t na = worldA.size();
+    const std::size_t nb = worldB.size();
+    if (na < 2 || nb < 2) return;
+
+    const double tolerance = options.tolerance;
+    const std::size_t stride = na + nb;
+    const std::size_t firstNew = out.size();
+
+    thread_local std::vector<glm::dvec2> points, piece, half, temp, curveA, curveB, evalTemp;
+    thread_local std::vector<Frame> frames;
+    piece.resize(stride);
+    half.resize(2 * std::max(na, nb));
+    temp.resize(std::max(na, nb));
+    points.clear();
+    for (const auto& p : worldA) points.emplace_back(p);
+    for (const auto& p : worldB) points.emplace_back(p);
+    curveA.assign(points.begin(), points.begin() + na);
+    curveB.assign(points.begin() + na, points.end());
+    const std::vector<glm::dvec2> derivA = derivativePoints(curveA), derivB = derivativePoints(curveB);
+    frames.assign(1, Frame{0.0, 1.0, 0.0, 1.0, 0});
+
+    while (!frames.empty()) {
+        const Frame f = frames.back();
+        frames.pop_back();
+        std::copy(points.end() - stride, points.end(), piece.begin());
+        points.resize(points.size() - stride);
+        const glm::dvec2* pa = piece.data();
+        const glm::dvec2* pb = piece.data() + na;
+
+        const Box boxA = boundsOf(pa, na);
+        const Box boxB = boundsOf(pb, nb);
+        if (!overlaps(boxA, boxB, tolerance)) continue;
+
+        const bool flatA = isFlat(pa, na, tolerance);
+        const bool flatB = isFlat(pb, nb, tolerance);
+        if ((flatA && flatB) || f.depth >= options.maxDepth) {
+            double u, v;
+            const glm::dvec2 r = pa[na - 1] - pa[0];
+            const glm::dvec2 s = pb[nb - 1] - pb[0];
+            if (segmentIntersection(pa[0], r, pb[0], s, u, v)) {
+                double ta = f.a0 + glm::clamp(u, 0.0, 1.0) * (f.a1 - f.a0);
+                double tb = f.b0 + glm::clamp(v, 0.0, 1.0) * (f.b1 - f.b0);
+                refineParameters(curveA, derivA, curveB, derivB, evalTemp, ta, tb);
+                CurveIntersection hit;
+                hit.curveA = indexA;
+                hit.curveB = indexB;
+                hit.tA = static_cast<float>(ta);
+                hit.tB = static_cast<float>(tb);
+                hit.point = glm::vec2(0.5 * (evaluateAt(curveA, evalTemp, ta) + evaluateAt(curveB, evalTemp, tb)));
+                out.push_back(hit);
+            }
+            continue;
+        }
+
+        // On coupe le morceau le moins plat, ou le plus grand
+        const glm::dvec2 extentA = boxA.max - boxA.min, extentB = boxB.max - boxB.min;
+        const bool splitA = flatB || (!flatA && std::max(extentA.x, extentA.y) >= std::max(extentB.x, extentB.y));
+        const std::size_t n = splitA ? na : nb;
+        splitHalf(splitA ? pa : pb, n, half.data(), half.data() + n, temp.data());
+
+        // Droite puis gauche : la moitié gauche est traitée en premier
+        for (int side = 1; side >= 0; --side) {
+            const glm::dvec2* sub = half.data() + side * n;
+            const std::size_t base = points.size();
+            points.resize(base + stride);
+            if (splitA) {
+                std::copy(sub, sub + na, points.begin() + base);
+                std::copy(pb, pb + nb, points.begin() + base + na);
+            } else {
+                std::copy(pa, pa + na, points.begin() + base);
+                std::copy(sub, sub + nb, points.begin() + base + na);
+            }
+            Frame child = f;
+            child.depth = f.depth + 1;
+            if (splitA) {
+                const double mid = 0.5 * (f.a0 + f.a1);
+                (side == 0 ? child.a1 : child.a0) = mid;
+            } else {
+                const double mid = 0.5 * (f.b0 + f.b1);
+                (side == 0 ? child.b1 : child.b0) = mid;
+            }
+            frames.push_back(child);
+        }
+    }
+
+    // Un même croisement peut être trouvé par deux morceaux voisins : on fusionne les doublons
+    std::sort(out.begin() + firstNew, out.end(), [](const CurveIntersection& l, const CurveIntersection& r) {
+        return l.tA < r.tA;
+    });
+    std::size_t kept = firstNew;
+    for (std::size_t i = firstNew; i < out.size(); ++i) {
+        bool duplicate = false;
+        for (std::size_t j = firstNew; j < kept && !duplicate; ++j)
+            duplicate = glm::distance(out[i].point, out[j].point) <= 4.0f * options.tolerance;
+        if (!duplicate) out[kept++] = out[i];
+    }
+    out.resize(kept);
+}
+
+std::vector<CurveIntersection> intersectAll(const std::vector<BezierCurveData>& curves,
+                                            const IntersectionOptions& options, ThreadPool& pool) {
+    // Phase large : tri des boîtes sur x puis balayage avec la liste des boîtes encore ouvertes.
+    // Les polygones transformés sont mis en cache ici, avant la lecture concurrente.
+    std::vector<Box> boxes(curves.size());
+    std::vector<int> order;
+    for (std::size_t i = 0; i < curves.size(); ++i) {
+        const auto& pts = curves[i].worldControlPoints();
+        if (pts.size() < 2) continue;
+        boxes[i] = Box{glm::dvec2(pts[0]), glm::dvec2(pts[0])};
+        for (const auto& p : pts) {
+            boxes[i].min = glm::min(boxes[i].min, glm::dvec2(p));
+            boxes[i].max = glm::max(boxes[i].max, glm::dvec2(p));
+        }
+        order.push_back(static_cast<int>(i));
+    }
+    std::sort(order.begin(), order.end(), [&](int l, int r) { return boxes[l].min.x < boxes[r].min.x; });
+
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<int> active;
+    for (int current : order) {
+        const Box& box = boxes[current];
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int other) {
+            return boxes[other].max.x < box.min.x - options.tolerance;
+        }), active.end());
+        for (int other : active) {
+            if (overlaps(boxes[other], box, options.tolerance))
+                pairs.emplace_back(std::min(current, other), std::max(current, other));
+        }
+        active.push_back(current);
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    // Phase fine : une liste de résultats par paire, concaténées dans l'ordre des paires
+    std::vector<std::vector<CurveIntersection>> perPair(pairs.size());
+    pool.parallelFor(pairs.size(), [&](std::size_t k) {
+        const int i = pairs[k].first, j = pairs[k].second;
+        intersectCurves(curves[i], curves[j], perPair[k], options, i, j);
+    });
+
+    std::vector<CurveIntersection> result;
+    for (const auto& hits : perPair) result.insert(result.end(), hits.begin(), hits.end());
+    return result;
+}
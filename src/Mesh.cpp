@@ -2,27 +2,204 @@
 // Created by robai on 18/06/2025.
 //
 #include "../include/Mesh.hpp"
+#include "../include/BezierSimd.hpp"
+#include "../include/SimdTarget.hpp"
+#include <algorithm>
+#include <cmath>
 
-void Mesh::computeNormals() {
-    normals.clear();
-    normals.resize(vertices.size(), glm::vec3(0.0f));
+namespace {
 
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        unsigned int i0 = indices[i];
-        unsigned int i1 = indices[i + 1];
-        unsigned int i2 = indices[i + 2];
+// Faces dont les normales sont calculées d'un coup avant d'être dispersées sur les sommets
+constexpr std::size_t kBlock = 256;
+// Sommets par tâche lors de la réduction
+constexpr std::size_t kVertexChunk = 4096;
+// En dessous de ce nombre de faces par thread, un tampon de plus coûte plus qu'il ne rapporte
+constexpr std::size_t kMinFacesPerThread = 1 << 16;
+// Chaque thread supplémentaire alloue un tampon de la taille des sommets
+constexpr unsigned kMaxPartialSums = 8;
 
-        glm::vec3 v0 = vertices[i0];
-        glm::vec3 v1 = vertices[i1];
-        glm::vec3 v2 = vertices[i2];
+// Mêmes opérations que glm::cross puis glm::normalize, pour que tous les chemins coïncident
+glm::vec3 faceNormal(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, bool unit) {
+    const glm::vec3 n = glm::cross(v1 - v0, v2 - v0);
+    if (!unit) return n;
+    const float len2 = glm::dot(n, n);
+    return (len2 > 0.0f) ? n * (1.0f / std::sqrt(len2)) : glm::vec3(0.0f);
+}
 
-        glm::vec3 n = glm::normalize(glm::cross(v1 - v0, v2 - v0));
-        normals[i0] += n;
-        normals[i1] += n;
-        normals[i2] += n;
+// Sommets et triangles lus par les noyaux, qu'ils viennent d'un Mesh ou d'une extrusion
+struct Faces {
+    const glm::vec3* vertices;
+    const unsigned int* indices;
+};
+
+glm::vec3 normalizeOrZero(const glm::vec3& n) {
+    const float len2 = glm::dot(n, n);
+    return (len2 > 0.0f) ? n * (1.0f / std::sqrt(len2)) : glm::vec3(0.0f);
+}
+
+void faceNormalsScalar(const Faces& faces, bool unit, std::size_t first, std::size_t last, glm::vec3* out) {
+    const unsigned int* idx = faces.indices;
+    for (std::size_t f = first; f < last; ++f)
+        out[f - first] = faceNormal(faces.vertices[idx[3 * f]], faces.vertices[idx[3 * f + 1]], faces.vertices[idx[3 * f + 2]], unit);
+}
+
+#ifdef BEZIER_SIMD_X86
+
+// Chargement en structure de tableaux : composante c des sommets k (0, 1, 2) des W faces
+template <std::size_t W>
+void loadFaces(const Faces& faces, std::size_t f, float (&soa)[3][3][W]) {
+    const unsigned int* idx = faces.indices + 3 * f;
+    for (std::size_t j = 0; j < W; ++j)
+        for (int k = 0; k < 3; ++k) {
+            const glm::vec3& v = faces.vertices[idx[3 * j + k]];
+            soa[k][0][j] = v.x;
+            soa[k][1][j] = v.y;
+            soa[k][2][j] = v.z;
+        }
+}
+
+BEZIER_TARGET("sse2")
+std::size_t faceNormalsSse(const Faces& faces, bool unit, std::size_t first, std::size_t last, glm::vec3* out) {
+    constexpr std::size_t W = 4;
+    alignas(16) float soa[3][3][W];
+    alignas(16) float nx[W], ny[W], nz[W];
+    std::size_t f = first;
+    for (; f + W <= last; f += W) {
+        loadFaces(faces, f, soa);
+        const __m128 ax = _mm_sub_ps(_mm_load_ps(soa[1][0]), _mm_load_ps(soa[0][0]));
+        const __m128 ay = _mm_sub_ps(_mm_load_ps(soa[1][1]), _mm_load_ps(soa[0][1]));
+        const __m128 az = _mm_sub_ps(_mm_load_ps(soa[1][2]), _mm_load_ps(soa[0][2]));
+        const __m128 bx = _mm_sub_ps(_mm_load_ps(soa[2][0]), _mm_load_ps(soa[0][0]));
+        const __m128 by = _mm_sub_ps(_mm_load_ps(soa[2][1]), _mm_load_ps(soa[0][1]));
+        const __m128 bz = _mm_sub_ps(_mm_load_ps(soa[2][2]), _mm_load_ps(soa[0][2]));
+        __m128 cx = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(by, az));
+        __m128 cy = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(bz, ax));
+        __m128 cz = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(bx, ay));
+        if (unit) {
+            const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz));
+            const __m128 valid = _mm_cmpgt_ps(len2, _mm_setzero_ps());
+            const __m128 inv = _mm_and_ps(valid, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len2)));
+            cx = _mm_mul_ps(cx, inv);
+            cy = _mm_mul_ps(cy, inv);
+            cz = _mm_mul_ps(cz, inv);
+        }
+        _mm_store_ps(nx, cx);
+        _mm_store_ps(ny, cy);
+        _mm_store_ps(nz, cz);
+        for (std::size_t j = 0; j < W; ++j) out[f - first + j] = glm::vec3(nx[j], ny[j], nz[j]);
+    }
+    return f;
+}
+
+BEZIER_TARGET("avx2")
+std::size_t faceNormalsAvx2(const Faces& faces, bool unit, std::size_t first, std::size_t last, glm::vec3* out) {
+    constexpr std::size_t W = 8;
+    alignas(32) float soa[3][3][W];
+    alignas(32) float nx[W], ny[W], nz[W];
+    std::size_t f = first;
+    for (; f + W <= last; f += W) {
+        loadFaces(faces, f, soa);
+        const __m256 ax = _mm256_sub_ps(_mm256_load_ps(soa[1][0]), _mm256_load_ps(soa[0][0]));
+        const __m256 ay = _mm256_sub_ps(_mm256_load_ps(soa[1][1]), _mm256_load_ps(soa[0][1]));
+        const __m256 az = _mm256_sub_ps(_mm256_load_ps(soa[1][2]), _mm256_load_ps(soa[0][2]));
+        const __m256 bx = _mm256_sub_ps(_mm256_load_ps(soa[2][0]), _mm256_load_ps(soa[0][0]));
+        const __m256 by = _mm256_sub_ps(_mm256_load_ps(soa[2][1]), _mm256_load_ps(soa[0][1]));
+        const __m256 bz = _mm256_sub_ps(_mm256_load_ps(soa[2][2]), _mm256_load_ps(soa[0][2]));
+        __m256 cx = _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(by, az));
+        __m256 cy = _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(bz, ax));
+        __m256 cz = _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(bx, ay));
+        if (unit) {
+            const __m256 len2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, cx), _mm256_mul_ps(cy, cy)), _mm256_mul_ps(cz, cz));
+            const __m256 valid = _mm256_cmp_ps(len2, _mm256_setzero_ps(), _CMP_GT_OQ);
+            const __m256 inv = _mm256_and_ps(valid, _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(len2)));
+            cx = _mm256_mul_ps(cx, inv);
+            cy = _mm256_mul_ps(cy, inv);
+            cz = _mm256_mul_ps(cz, inv);
+        }
+        _mm256_store_ps(nx, cx);
+        _mm256_store_ps(ny, cy);
+        _mm256_store_ps(nz, cz);
+        for (std::size_t j = 0; j < W; ++j) out[f - first + j] = glm::vec3(nx[j], ny[j], nz[j]);
+    }
+    return f;
+}
+
+#endif
+
+void faceNormalsSimd(const Faces& faces, bool unit, std::size_t first, std::size_t last, glm::vec3* out) {
+    std::size_t done = first;
+    switch (detectSimdLevel()) {
+#ifdef BEZIER_SIMD_X86
+        case SimdLevel::AVX2: done = faceNormalsAvx2(faces, unit, first, last, out); break;
+        case SimdLevel::SSE: done = faceNormalsSse(faces, unit, first, last, out); break;
+#endif
+        default: break;
     }
+    faceNormalsScalar(faces, unit, done, last, out + (done - first));
+}
 
-    for (auto& n : normals) {
-        n = glm::normalize(n);
+// Ajoute aux sommes de sommets les normales des faces [first, last), dans l'ordre des faces
+void accumulateFaces(const Faces& faces, bool unit, bool simd, std::size_t first, std::size_t last, glm::vec3* sums) {
+    glm::vec3 block[kBlock];
+    const unsigned int* idx = faces.indices;
+    for (std::size_t f = first; f < last; f += kBlock) {
+        const std::size_t end = std::min(f + kBlock, last);
+        if (simd) faceNormalsSimd(faces, unit, f, end, block);
+        else faceNormalsScalar(faces, unit, f, end, block);
+        for (std::size_t j = f; j < end; ++j) {
+            sums[idx[3 * j]] += block[j - f];
+            sums[idx[3 * j + 1]] += block[j - f];
+            sums[idx[3 * j + 2]] += block[j - f];
+        }
     }
-}
\ No newline at end of file
+}
+
+}
+
+void computeVertexNormals(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices,
+                          std::vector<glm::vec3>& normals, NormalWeighting weighting, NormalMethod method,
+                          ThreadPool& pool) {
+    const bool unit = weighting == NormalWeighting::Uniform;
+    const bool simd = method == NormalMethod::Simd;
+    const std::size_t faceCount = indices.size() / 3;
+    const Faces faces{vertices.data(), indices.data()};
+    normals.assign(vertices.size(), glm::vec3(0.0f));
+
+    unsigned threads = 1;
+    if (method != NormalMethod::Serial) {
+        const std::size_t useful = std::max<std::size_t>(faceCount / kMinFacesPerThread, 1);
+        threads = static_cast<unsigned>(std::min<std::size_t>({pool.size(), kMaxPartialSums, useful}));
+    }
+
+    if (threads == 1) {
+        accumulateFaces(faces, unit, simd, 0, faceCount, normals.data());
+        for (auto& n : normals) n = normalizeOrZero(n);
+        return;
+    }
+
+    // Plages de faces fixées par le nombre de threads : le thread 0 écrit directement dans
+    // normals, les autres dans leur propre tampon
+    std::vector<std::vector<glm::vec3>> partial(threads - 1);
+    pool.parallelFor(threads, [&](std::size_t r) {
+        glm::vec3* sums = normals.data();
+        if (r > 0) {
+            partial[r - 1].assign(vertices.size(), glm::vec3(0.0f));
+            sums = partial[r - 1].data();
+        }
+        accumulateFaces(faces, unit, simd, faceCount * r / threads, faceCount * (r + 1) / threads, sums);
+    });
+
+    const std::size_t vertexChunks = (vertices.size() + kVertexChunk - 1) / kVertexChunk;
+    pool.parallelFor(vertexChunks, [&](std::size_t c) {
+        const std::size_t first = c * kVertexChunk, last = std::min(first + kVertexChunk, vertices.size());
+        for (std::size_t v = first; v < last; ++v) {
+            glm::vec3 sum = normals[v];
+            for (const auto& buffer : partial) sum += buffer[v];
+            normals[v] = normalizeOrZero(sum);
+        }
+    });
+}
+
+void Mesh::computeNormals(NormalWeighting weighting, NormalMethod method, ThreadPool& pool) {
+    computeVertexNormals(vertices, indices, normals, weighting, method, pool);
+}
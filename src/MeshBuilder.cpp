@@ -0,0 +1,85 @@
+#include "../include/MeshBuilder.hpp"
+#include <utility>
+
+std::vector<std::uint32_t> InterleavedMesh::triangleList() const {
+    const std::size_t count = indexCount();
+    std::vector<std::uint32_t> triangles;
+    if (primitive == Primitive::Triangles) {
+        triangles.resize(count);
+        for (std::size_t k = 0; k < count; ++k) triangles[k] = index(k);
+        return triangles;
+    }
+    // Dans une bande, le triangle k est (s[k], s[k+1], s[k+2]) si k est pair et
+    // (s[k+1], s[k], s[k+2]) sinon, comme GL_TRIANGLE_STRIP
+    const std::uint32_t restart = restartIndex();
+    std::size_t start = 0;
+    for (std::size_t k = 0; k <= count; ++k) {
+        if (k < count && index(k) != restart) continue;
+        for (std::size_t t = start; t + 2 < k; ++t) {
+            const bool odd = (t - start) & 1;
+            triangles.push_back(index(odd ? t + 1 : t));
+            triangles.push_back(index(odd ? t : t + 1));
+            triangles.push_back(index(t + 2));
+        }
+        start = k + 1;
+    }
+    return triangles;
+}
+
+glm::vec3 InterleavedMesh::position(std::size_t i) const {
+    const VertexBlock& b = vertexData[i * blocksPerVertex(format)];
+    return glm::vec3(b.values[0], b.values[1], b.values[2]);
+}
+
+glm::vec3 InterleavedMesh::normal(std::size_t i) const {
+    if (!hasNormals(format)) return glm::vec3(0.0f);
+    const VertexBlock* b = &vertexData[i * blocksPerVertex(format)];
+    return glm::vec3(b[0].values[3], b[1].values[0], b[1].values[1]);
+}
+
+glm::vec2 InterleavedMesh::uv(std::size_t i) const {
+    if (!hasUV(format)) return glm::vec2(0.0f);
+    const VertexBlock& b = vertexData[i * blocksPerVertex(format) + 1];
+    return glm::vec2(b.values[2], b.values[3]);
+}
+
+namespace {
+
+void allocate(InterleavedMesh& mesh, VertexFormat format, std::size_t vertexCount, std::size_t indexCount,
+              Primitive primitive) {
+    mesh.format = format;
+    mesh.primitive = primitive;
+    mesh.indexType = InterleavedMesh::indexTypeFor(vertexCount);
+    mesh.vertexData.resize(vertexCount * InterleavedMesh::blocksPerVertex(format));
+    // Le tableau inutilisé est libéré : seul le tampon à la bonne largeur occupe de la mémoire
+    if (mesh.indexType == IndexType::UInt16) {
+        mesh.indices16.resize(indexCount);
+        std::vector<std::uint32_t>().swap(mesh.indices32);
+    } else {
+        mesh.indices32.resize(indexCount);
+        std::vector<std::uint16_t>().swap(mesh.indices16);
+    }
+}
+
+}
+
+MeshBuilder::MeshBuilder(VertexFormat format, std::size_t vertexCount, std::size_t indexCount, Primitive primitive)
+    : blocks(InterleavedMesh::blocksPerVertex(format)) {
+    allocate(mesh, format, vertexCount, indexCount, primitive);
+}
+
+MeshBuilder::MeshBuilder(InterleavedMesh&& existing)
+    : mesh(std::move(existing)), blocks(InterleavedMesh::blocksPerVertex(mesh.format)), cursor(mesh.indexCount()) {}
+
+MeshBuilder::MeshBuilder(InterleavedMesh&& existing, VertexFormat format, std::size_t vertexCount, std::size_t indexCount,
+                         Primitive primitive)
+    : mesh(std::move(existing)), blocks(InterleavedMesh::blocksPerVertex(format)) {
+    allocate(mesh, format, vertexCount, indexCount, primitive);
+}
+
+InterleavedMesh MeshBuilder::finish() {
+    InterleavedMesh result = std::move(mesh);
+    mesh = InterleavedMesh();
+    cursor = 0;
+    return result;
+}
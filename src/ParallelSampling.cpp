@@ -0,0 +1,106 @@
+#include "ParallelSampling.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+// Coût visé par tâche, en opérations de De Casteljau (points × degré²)
+constexpr std::size_t kTaskCost = 1 << 16;
+
+struct SampleTask {
+    std::size_t firstCurve, lastCurve;    // courbes [firstCurve, lastCurve)
+    std::size_t firstSample, lastSample;  // plage d'échantillons si la tâche couvre une seule courbe
+};
+
+std::size_t sampleCost(const BezierCurveData& curve, int segments) {
+    const std::size_t n = curve.controlPoints.size();
+    return static_cast<std::size_t>(segments + 1) * std::max<std::size_t>(n * n / 2, 1);
+}
+
+}
+
+void sampleCurvesParallel(const std::vector<BezierCurveData>& curves, int segments, BezierMethod method,
+                          SampledCurves& out, ThreadPool& pool) {
+    segments = std::max(segments, 1);
+    const std::size_t perCurve = static_cast<std::size_t>(segments) + 1;
+
+    out.offsets.resize(curves.size() + 1);
+    out.offsets[0] = 0;
+    for (std::size_t i = 0; i < curves.size(); ++i)
+        out.offsets[i + 1] = out.offsets[i] + (curves[i].controlPoints.size() < 2 ? 0 : perCurve);
+    out.points.resize(out.offsets.back());
+
+    // Les caches paresseux sont construits ici, avant que plusieurs threads lisent la même courbe
+    for (const auto& curve : curves) curve.prepareCaches(method);
+
+    // Les différences avant dépendent du point d'amorçage : jamais de découpage pour elles
+    const bool splittable = method != BezierMethod::ForwardDifference;
+
+    std::vector<SampleTask> tasks;
+    std::size_t groupStart = 0, groupCost = 0;
+    for (std::size_t i = 0; i < curves.size(); ++i) {
+        if (curves[i].controlPoints.size() < 2) continue;
+        const std::size_t cost = sampleCost(curves[i], segments);
+
+        if (splittable && cost > kTaskCost) {
+            if (groupCost > 0) tasks.push_back({groupStart, i, 0, 0});
+            const std::size_t chunk = std::max<std::size_t>(perCurve * kTaskCost / cost, 8);
+            for (std::size_t s = 0; s < perCurve; s += chunk)
+                tasks.push_back({i, i + 1, s, std::min(s + chunk, perCurve)});
+            groupStart = i + 1;
+            groupCost = 0;
+            continue;
+        }
+
+        if (groupCost == 0) groupStart = i;
+        groupCost += cost;
+        if (groupCost >= kTaskCost) {
+            tasks.push_back({groupStart, i + 1, 0, 0});
+            groupCost = 0;
+        }
+    }
+    if (groupCost > 0) tasks.push_back({groupStart, curves.size(), 0, 0});
+
+    pool.parallelFor(tasks.size(), [&](std::size_t k) {
+        const SampleTask& task = tasks[k];
+        if (task.lastSample > task.firstSample) {
+            // Plage de paramètres d'une longue courbe : mêmes t que sampleUniform
+            thread_local std::vector<float> ts;
+            ts.resize(task.lastSample - task.firstSample);
+            for (std::size_t j = task.firstSample; j < task.lastSample; ++j)
+                ts[j - task.firstSample] = j / (float)segments;
+            curves[task.firstCurve].evaluateMany(ts.data(), ts.size(),
+                                                 &out.points[out.offsets[task.firstCurve] + task.firstSample], method);
+            return;
+        }
+        for (std::size_t i = task.firstCurve; i < task.lastCurve; ++i) {
+            if (out.offsets[i + 1] > out.offsets[i])
+                curves[i].sampleUniform(segments, &out.points[out.offsets[i]], method);
+        }
+    });
+}
+
+void refreshSampleCaches(const std::vector<BezierCurveData>& curves, const SamplingOptions& options,
+                         ThreadPool& pool) {
+    // Appelé à chaque image : la liste garde sa capacité et la tâche est passée par référence
+    // (std::ref), pour qu'aucun des deux n'alloue une fois la liste à sa taille
+    thread_local std::vector<std::size_t> stale;
+    stale.clear();
+    for (std::size_t i = 0; i < curves.size(); ++i)
+        if (!curves[i].hasSampled(options)) stale.push_back(i);
+
+    // Chaque tâche ne touche que le cache de sa propre courbe
+    const std::size_t* indices = stale.data();
+    auto refresh = [&](std::size_t k) { curves[indices[k]].sampled(options); };
+    pool.parallelFor(stale.size(), std::ref(refresh));
+}
+
+void bakeTransforms(std::vector<BezierCurveData>& curves, ThreadPool& pool) {
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < curves.size(); ++i)
+        if (curves[i].hasTransformation()) pending.push_back(i);
+
+    pool.parallelFor(pending.size(), [&](std::size_t k) {
+        curves[pending[k]].bake();
+    });
+}
@@ -0,0 +1,366 @@
+#include "SpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr int kMaxGridResolution = 1024;
+constexpr int kPointsPerCell = 4;
+constexpr int kCurvesPerLeaf = 4;
+// La grille est redimensionnée quand plus d'un point sur kMaxOutsideFraction en est sorti
+constexpr std::size_t kMaxOutsideFraction = 8;
+
+float cross2(const glm::vec2& o, const glm::vec2& a, const glm::vec2& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+float distanceToSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    const glm::vec2 ab = b - a;
+    const float len2 = glm::dot(ab, ab);
+    const float u = (len2 > 0.0f) ? glm::clamp(glm::dot(p - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+    return glm::distance(p, a + u * ab);
+}
+
+float distanceToBox(const glm::vec2& p, const glm::vec2& min, const glm::vec2& max) {
+    return glm::length(glm::max(glm::max(min - p, p - max), glm::vec2(0.0f)));
+}
+
+// Enveloppe convexe par chaîne monotone d'Andrew, sens trigonométrique
+std::vector<glm::vec2> convexHull(std::vector<glm::vec2> pts) {
+    std::sort(pts.begin(), pts.end(), [](const glm::vec2& a, const glm::vec2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+    if (pts.size() < 3) return pts;
+
+    std::vector<glm::vec2> hull(2 * pts.size());
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        while (k >= 2 && cross2(hull[k - 2], hull[k - 1], pts[i]) <= 0.0f) --k;
+        hull[k++] = pts[i];
+    }
+    for (std::size_t i = pts.size() - 1, lower = k + 1; i > 0; --i) {
+        while (k >= lower && cross2(hull[k - 2], hull[k - 1], pts[i - 1]) <= 0.0f) --k;
+        hull[k++] = pts[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+// Minorant de la distance à la courbe : 0 à l'intérieur de l'enveloppe
+float distanceToHull(const glm::vec2& p, const std::vector<glm::vec2>& hull) {
+    if (hull.empty()) return std::numeric_limits<float>::max();
+    if (hull.size() == 1) return glm::distance(p, hull[0]);
+
+    bool inside = hull.size() >= 3;
+    float best = std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i < hull.size(); ++i) {
+        const glm::vec2& a = hull[i];
+        const glm::vec2& b = hull[(i + 1) % hull.size()];
+        if (cross2(a, b, p) < 0.0f) inside = false;
+        best = std::min(best, distanceToSegment(p, a, b));
+    }
+    return inside ? 0.0f : best;
+}
+
+float distanceToPolyline(const glm::vec2& p, const std::vector<glm::vec2>& polyline) {
+    if (polyline.empty()) return std::numeric_limits<float>::max();
+    if (polyline.size() == 1) return glm::distance(p, polyline[0]);
+    float best = std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i + 1 < polyline.size(); ++i)
+        best = std::min(best, distanceToSegment(p, polyline[i], polyline[i + 1]));
+    return best;
+}
+
+}
+
+void CurveSpatialIndex::update(const std::vector<BezierCurveData>& curves) {
+    // Courbe ou point ajouté / retiré : les entrées sont à répartir de nouveau, tout est reconstruit
+    bool resized = versions.size() != curves.size();
+    for (std::size_t c = 0; !resized && c < curves.size(); ++c)
+        resized = pointBase[c + 1] - pointBase[c] != static_cast<int>(curves[c].controlPoints.size());
+    if (resized) {
+        rebuild(curves);
+        return;
+    }
+
+    // Déplacement de points (glisser-déposer, transformation) : seules les courbes modifiées
+    bool changed = false;
+    for (std::size_t c = 0; c < curves.size(); ++c) {
+        if (versions[c] == curves[c].version()) continue;
+        updateCurve(curves, c);
+        changed = true;
+    }
+    if (!changed) return;
+
+    if (outsideCount * kMaxOutsideFraction > entries.size()) buildGrid();
+    refitBvh();
+}
+
+void CurveSpatialIndex::rebuild(const std::vector<BezierCurveData>& curves) {
+    versions.resize(curves.size());
+    curveBounds.assign(curves.size(), CurveBounds());
+    pointBase.assign(curves.size() + 1, 0);
+    for (std::size_t c = 0; c < curves.size(); ++c)
+        pointBase[c + 1] = pointBase[c] + static_cast<int>(curves[c].controlPoints.size());
+
+    entries.assign(pointBase.back(), GridEntry());
+    for (std::size_t c = 0; c < curves.size(); ++c)
+        for (int i = 0; i < pointBase[c + 1] - pointBase[c]; ++i)
+            entries[pointBase[c] + i].ref = {static_cast<int>(c), i};
+
+    // Sans grille, updateCurve ne fait que copier les positions ; buildGrid les range ensuite
+    cellHead.clear();
+    for (std::size_t c = 0; c < curves.size(); ++c) updateCurve(curves, c);
+    buildGrid();
+
+    curveOrder.clear();
+    for (std::size_t c = 0; c < curves.size(); ++c)
+        if (!curves[c].controlPoints.empty()) curveOrder.push_back(static_cast<int>(c));
+    nodes.clear();
+    if (!curveOrder.empty()) buildBvh(0, static_cast<int>(curveOrder.size()));
+}
+
+// Boîte, enveloppe et entrées de la courbe c d'après ses points actuels ; un point qui change
+// de cellule passe d'une liste à l'autre
+void CurveSpatialIndex::updateCurve(const std::vector<BezierCurveData>& curves, std::size_t c) {
+    const auto& pts = curves[c].worldControlPoints();
+    versions[c] = curves[c].version();
+    CurveBounds& b = curveBounds[c];
+    if (pts.empty()) {
+        b = CurveBounds();
+        return;
+    }
+
+    b.min = b.max = pts[0];
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        b.min = glm::min(b.min, pts[i]);
+        b.max = glm::max(b.max, pts[i]);
+
+        const int k = pointBase[c] + static_cast<int>(i);
+        GridEntry& e = entries[k];
+        e.position = pts[i];
+        if (cellHead.empty()) continue;
+
+        bool outside = false;
+        const int cell = cellOf(pts[i], outside);
+        if (outside != e.outside) {
+            if (outside) ++outsideCount;
+            else --outsideCount;
+            e.outside = outside;
+        }
+        if (cell != e.cell) {
+            unlink(k);
+            e.cell = cell;
+            link(k);
+        }
+    }
+    b.hull = convexHull(pts);
+}
+
+// Grille d'environ kPointsPerCell points par cellule sur la boîte de tous les points
+void CurveSpatialIndex::buildGrid() {
+    gridWidth = gridHeight = 0;
+    cellHead.clear();
+    outsideCount = 0;
+    if (entries.empty()) return;
+
+    glm::vec2 min = entries[0].position, max = entries[0].position;
+    for (const auto& e : entries) {
+        min = glm::min(min, e.position);
+        max = glm::max(max, e.position);
+    }
+    const glm::vec2 extent = glm::max(max - min, glm::vec2(1e-6f));
+    const float area = extent.x * extent.y;
+    cellSize = std::sqrt(area * kPointsPerCell / entries.size());
+    cellSize = std::max({cellSize, extent.x / kMaxGridResolution, extent.y / kMaxGridResolution});
+    gridOrigin = min;
+    gridWidth = std::min(static_cast<int>(extent.x / cellSize) + 1, kMaxGridResolution);
+    gridHeight = std::min(static_cast<int>(extent.y / cellSize) + 1, kMaxGridResolution);
+
+    cellHead.assign(gridWidth * gridHeight, -1);
+    for (int k = 0; k < static_cast<int>(entries.size()); ++k) {
+        GridEntry& e = entries[k];
+        e.cell = cellOf(e.position, e.outside);
+        if (e.outside) ++outsideCount;
+        link(k);
+    }
+}
+
+// Cellule de p ; un point hors de la grille va dans la cellule du bord la plus proche, ce qui
+// garde le minorant de nearestControlPoint valable (il reste au-delà de cette cellule)
+int CurveSpatialIndex::cellOf(const glm::vec2& p, bool& outside) const {
+    const glm::vec2 g = glm::floor((p - gridOrigin) / cellSize);
+    outside = g.x < 0.0f || g.y < 0.0f || g.x >= gridWidth || g.y >= gridHeight;
+    const int cx = static_cast<int>(glm::clamp(g.x, 0.0f, gridWidth - 1.0f));
+    const int cy = static_cast<int>(glm::clamp(g.y, 0.0f, gridHeight - 1.0f));
+    return cellIndex(cx, cy);
+}
+
+void CurveSpatialIndex::link(int entry) {
+    GridEntry& e = entries[entry];
+    e.next = cellHead[e.cell];
+    cellHead[e.cell] = entry;
+}
+
+void CurveSpatialIndex::unlink(int entry) {
+    int* slot = &cellHead[entries[entry].cell];
+    while (*slot != entry) slot = &entries[*slot].next;
+    *slot = entries[entry].next;
+}
+
+// Partage médian sur l'axe le plus long des centres de boîtes
+int CurveSpatialIndex::buildBvh(int first, int count) {
+    const int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+
+    glm::vec2 min = curveBounds[curveOrder[first]].min, max = curveBounds[curveOrder[first]].max;
+    glm::vec2 cmin(std::numeric_limits<float>::max()), cmax(-std::numeric_limits<float>::max());
+    for (int i = first; i < first + count; ++i) {
+        const CurveBounds& b = curveBounds[curveOrder[i]];
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+        const glm::vec2 center = 0.5f * (b.min + b.max);
+        cmin = glm::min(cmin, center);
+        cmax = glm::max(cmax, center);
+    }
+    nodes[index].min = min;
+    nodes[index].max = max;
+
+    if (count <= kCurvesPerLeaf) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return index;
+    }
+
+    const int axis = (cmax.x - cmin.x >= cmax.y - cmin.y) ? 0 : 1;
+    const int half = count / 2;
+    std::nth_element(curveOrder.begin() + first, curveOrder.begin() + first + half, curveOrder.begin() + first + count,
+                     [&](int a, int b) {
+                         return curveBounds[a].min[axis] + curveBounds[a].max[axis] <
+                                curveBounds[b].min[axis] + curveBounds[b].max[axis];
+                     });
+
+    const int left = buildBvh(first, half);
+    const int right = buildBvh(first + half, count - half);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+// Boîtes recalculées des feuilles vers la racine, sans changer la forme de l'arbre : buildBvh
+// range chaque enfant après son parent dans nodes
+void CurveSpatialIndex::refitBvh() {
+    for (int n = static_cast<int>(nodes.size()) - 1; n >= 0; --n) {
+        BvhNode& node = nodes[n];
+        if (node.left >= 0) {
+            node.min = glm::min(nodes[node.left].min, nodes[node.right].min);
+            node.max = glm::max(nodes[node.left].max, nodes[node.right].max);
+            continue;
+        }
+        node.min = curveBounds[curveOrder[node.first]].min;
+        node.max = curveBounds[curveOrder[node.first]].max;
+        for (int i = node.first + 1; i < node.first + node.count; ++i) {
+            node.min = glm::min(node.min, curveBounds[curveOrder[i]].min);
+            node.max = glm::max(node.max, curveBounds[curveOrder[i]].max);
+        }
+    }
+}
+
+bool CurveSpatialIndex::nearestControlPoint(const glm::vec2& p, float maxDistance, ControlPointRef& result) const {
+    if (entries.empty()) return false;
+
+    const int cx = glm::clamp(static_cast<int>(std::floor((p.x - gridOrigin.x) / cellSize)), 0, gridWidth - 1);
+    const int cy = glm::clamp(static_cast<int>(std::floor((p.y - gridOrigin.y) / cellSize)), 0, gridHeight - 1);
+    float best = maxDistance * maxDistance;
+    bool found = false;
+
+    auto visit = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= gridWidth || y >= gridHeight) return;
+        const int c = cellIndex(x, y);
+        for (int i = cellHead[c]; i >= 0; i = entries[i].next) {
+            const glm::vec2 d = entries[i].position - p;
+            const float d2 = glm::dot(d, d);
+            if (d2 <= best) {
+                best = d2;
+                result = entries[i].ref;
+                found = true;
+            }
+        }
+    };
+
+    // Anneaux de cellules de plus en plus larges autour de la cellule de p
+    for (int r = 0; ; ++r) {
+        if (r == 0) {
+            visit(cx, cy);
+        } else {
+            for (int x = cx - r; x <= cx + r; ++x) {
+                visit(x, cy - r);
+                visit(x, cy + r);
+            }
+            for (int y = cy - r + 1; y <= cy + r - 1; ++y) {
+                visit(cx - r, y);
+                visit(cx + r, y);
+            }
+        }
+
+        // Minorant de la distance aux cellules non visitées (demi-plans hors du carré parcouru)
+        const glm::vec2 boxMin = gridOrigin + cellSize * glm::vec2(cx - r, cy - r);
+        const glm::vec2 boxMax = gridOrigin + cellSize * glm::vec2(cx + r + 1, cy + r + 1);
+        float bound = std::numeric_limits<float>::max();
+        if (cx - r > 0) bound = std::min(bound, std::max(0.0f, p.x - boxMin.x));
+        if (cy - r > 0) bound = std::min(bound, std::max(0.0f, p.y - boxMin.y));
+        if (cx + r < gridWidth - 1) bound = std::min(bound, std::max(0.0f, boxMax.x - p.x));
+        if (cy + r < gridHeight - 1) bound = std::min(bound, std::max(0.0f, boxMax.y - p.y));
+        if (bound == std::numeric_limits<float>::max() || bound * bound > best) break;
+    }
+    return found;
+}
+
+int CurveSpatialIndex::nearestCurve(const std::vector<BezierCurveData>& curves, const SamplingOptions& sampling,
+                                    const glm::vec2& p, float maxDistance, float* distance) const {
+    if (nodes.empty()) return -1;
+
+    float best = maxDistance;
+    int bestCurve = -1;
+    std::vector<int> stack{0};
+
+    while (!stack.empty()) {
+        const BvhNode& node = nodes[stack.back()];
+        stack.pop_back();
+        if (distanceToBox(p, node.min, node.max) > best) continue;
+
+        if (node.left < 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                const int c = curveOrder[i];
+                const CurveBounds& b = curveBounds[c];
+                if (distanceToBox(p, b.min, b.max) > best || distanceToHull(p, b.hull) > best) continue;
+
+                const float d = distanceToPolyline(p, curves[c].controlPoints.size() < 2
+                                                          ? curves[c].worldControlPoints()
+                                                          : curves[c].sampled(sampling));
+                if (d <= best) {
+                    best = d;
+                    bestCurve = c;
+                }
+            }
+            continue;
+        }
+
+        // Enfant le plus proche en dernier pour qu'il soit dépilé en premier
+        const float dl = distanceToBox(p, nodes[node.left].min, nodes[node.left].max);
+        const float dr = distanceToBox(p, nodes[node.right].min, nodes[node.right].max);
+        const int left = node.left, right = node.right;
+        if (dl < dr) {
+            stack.push_back(right);
+            stack.push_back(left);
+        } else {
+            stack.push_back(left);
+            stack.push_back(right);
+        }
+    }
+
+    if (distance && bestCurve >= 0) *distance = best;
+    return bestCurve;
+}
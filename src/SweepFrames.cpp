@@ -0,0 +1,96 @@
+#include "../include/SweepFrames.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Tangente par différence centrée (décentrée aux extrémités). Un point répété n'a pas de
+// direction propre : il reprend celle du point précédent, ou du premier point distinct au départ.
+glm::vec3 SweepFrames::tangentAt(std::size_t i) const {
+    const std::size_t n = points.size();
+    const glm::vec3 d = points[std::min(i + 1, n - 1)] - points[i > 0 ? i - 1 : 0];
+    const float len2 = glm::dot(d, d);
+    if (len2 > 0.0f) return d / std::sqrt(len2);
+    if (i > 0) return tangents[i - 1];
+    for (std::size_t j = 1; j < n; ++j)
+        if (points[j] != points[0]) return glm::normalize(points[j] - points[0]);
+    return glm::vec3(0.0f, 0.0f, 1.0f);  // chemin réduit à un point
+}
+
+// Premier repère construit comme l'ancien repère « up » : un chemin droit garde le même maillage
+glm::mat3 SweepFrames::initialFrame() const {
+    const glm::vec3& tangent = tangents[0];
+    glm::vec3 up(0.0f, 1.0f, 0.0f);
+    if (glm::abs(glm::dot(tangent, up)) > 0.99f) up = glm::vec3(1.0f, 0.0f, 0.0f);
+    const glm::vec3 side = glm::normalize(glm::cross(up, tangent));
+    return glm::mat3(side, glm::normalize(glm::cross(tangent, side)), tangent);
+}
+
+bool SweepFrames::update(const std::vector<glm::vec3>& path) {
+    const std::size_t n = path.size();
+    std::size_t first = 0, last = 0;  // points modifiés [first, last)
+    if (n != points.size()) {
+        last = n;
+    } else {
+        while (first < n && path[first] == points[first]) ++first;
+        if (first == n) {
+            firstChanged = lastChanged = 0;
+            return false;
+        }
+        last = n;
+        while (last > first && path[last - 1] == points[last - 1]) --last;
+    }
+    const bool resized = n != points.size();
+    points = path;
+    tangents.resize(n);
+    pathFrames.resize(n);
+    if (n == 0) {
+        firstChanged = lastChanged = 0;
+        ++frameVersion;
+        return true;
+    }
+
+    // La tangente i dépend des points i - 1 et i + 1 ; un point répété au départ peut en plus
+    // déplacer la première tangente, et donc tous les repères.
+    std::size_t begin = resized ? 0 : (first > 0 ? first - 1 : 0);
+    const glm::vec3 firstTangent = tangentAt(0);
+    if (firstTangent != tangents[0]) begin = 0;
+
+    std::size_t end = n;
+    for (std::size_t i = begin; i < n; ++i) {
+        const glm::vec3 tangent = tangentAt(i);
+        tangents[i] = tangent;
+        if (i == 0) {
+            pathFrames[0] = initialFrame();
+            continue;
+        }
+
+        // Double réflexion : le plan médiateur du segment amène le repère i - 1 au point i,
+        // une seconde réflexion aligne sa tangente sur tangents[i]
+        const glm::vec3 v1 = points[i] - points[i - 1];
+        const float c1 = glm::dot(v1, v1);
+        glm::vec3 normal = pathFrames[i - 1][1];
+        glm::vec3 reflected = tangents[i - 1];
+        if (c1 > 0.0f) {
+            normal -= (2.0f / c1) * glm::dot(v1, normal) * v1;
+            reflected -= (2.0f / c1) * glm::dot(v1, reflected) * v1;
+        }
+        const glm::vec3 v2 = tangent - reflected;
+        const float c2 = glm::dot(v2, v2);
+        if (c2 > 0.0f) normal -= (2.0f / c2) * glm::dot(v2, normal) * v2;
+
+        // Réorthonormalisation : l'erreur d'arrondi ne s'accumule pas le long du chemin
+        normal = glm::normalize(normal - glm::dot(normal, tangent) * tangent);
+        const glm::mat3 frame(glm::cross(normal, tangent), normal, tangent);
+        // Au-delà des points modifiés, un repère identique fixe tous les suivants
+        const bool same = !resized && i >= last && frame == pathFrames[i];
+        pathFrames[i] = frame;
+        if (same) {
+            end = i;
+            break;
+        }
+    }
+
+    firstChanged = std::min(begin, first);
+    lastChanged = std::max(end, last);
+    ++frameVersion;
+    return true;
+}
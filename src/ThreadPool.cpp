@@ -0,0 +1,100 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    const unsigned total = std::max(threadCount, 1u);
+    for (unsigned i = 0; i < total; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i + 1 < total; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) return;
+    if (queues.size() == 1 || count == 1) {
+        for (std::size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submitMutex);
+    job.store(&task);
+    remaining.store(count);
+
+    // Blocs contigus : chaque thread commence par des tâches voisines
+    const std::size_t threads = queues.size();
+    for (std::size_t q = 0; q < threads; ++q) {
+        const std::size_t begin = count * q / threads;
+        const std::size_t end = count * (q + 1) / threads;
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        queues[q]->tasks.clear();
+        queues[q]->head = 0;
+        for (std::size_t i = begin; i < end; ++i) queues[q]->tasks.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        ++generation;
+    }
+    wake.notify_all();
+
+    const unsigned self = static_cast<unsigned>(threads - 1);
+    while (runOne(self)) {}
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    finished.wait(lock, [this] { return remaining.load() == 0; });
+    job.store(nullptr);
+}
+
+// Prend une tâche à l'arrière de sa propre file, sinon à l'avant d'une autre
+bool ThreadPool::runOne(unsigned self) {
+    std::size_t index = 0;
+    bool found = false;
+
+    for (std::size_t k = 0; k < queues.size() && !found; ++k) {
+        Queue& queue = *queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.head == queue.tasks.size()) continue;
+        if (k == 0) {
+            index = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            index = queue.tasks[queue.head++];
+        }
+        found = true;
+    }
+    if (!found) return false;
+
+    (*job.load())(index);
+    if (remaining.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        finished.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned self) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        while (runOne(self)) {}
+    }
+}
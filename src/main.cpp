@@ -5,8 +5,15 @@
 #include <vector>
 #include "../include/Extrusion.hpp"
 #include "../include/Mesh.hpp"
+#include "../include/MeshBuilder.hpp"
+#include "../include/ParallelSampling.hpp"
 #include "../include/BezierCurveData.hpp"
+#include "../include/BezierSimd.hpp"
 #include "../include/Camera.hpp"
+#include "../include/CompositeBezier.hpp"
+#include "../include/BSplineCurve.hpp"
+#include "../include/SpatialIndex.hpp"
+#include "../include/Intersection.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../external/imgui/imgui.h"
@@ -18,24 +25,87 @@ const unsigned int WIDTH = 800;
 const unsigned int HEIGHT = 600;
 GLFWwindow* window = nullptr;
 
-Mesh extrudedMesh;
+// Extrusions paramétrées : leur tampon entrelacé est passé tel quel à OpenGL et mis à jour
+// sur place quand un curseur bouge
+enum class ExtrusionKind { Linear, Revolution, Sweep };
+LinearExtrusion linearExtrusion;
+RevolutionExtrusion revolutionExtrusion;
+SweepExtrusion sweepExtrusion;
+ExtrusionKind shownExtrusion = ExtrusionKind::Linear;
 bool showExtrusion = false;
 bool revolutionMode = false;
 bool generalizedMode = false;
+bool cubicProfile = false; // extruder la courbe active convertie en chaîne de cubiques
+int cubicSegmentCount = 0;
+// Tampons réutilisés d'une génération à l'autre : profil converti en cubiques, chemin du balayage
+std::vector<glm::vec2> cubicProfilePoints;
+std::vector<glm::vec3> sweepPathPoints;
+bool splineProfile = false; // lire les points de la courbe active comme une B-spline
+int splineDegree = 3;
+BSplineCurve splineCurve;
 
 std::vector<BezierCurveData> curves;
 int currentCurveIndex = -1;
 BezierMethod currentMethod = BezierMethod::DeCasteljau;
 int p_courbe = 100;
+SamplingMode samplingMode = SamplingMode::Uniform;
+float flatnessPixels = 0.5f; // tolérance de l'aplatissement adaptatif, en pixels
 bool rotating = false;
 glm::vec3 lightPosition = glm::vec3(1.0f, 1.0f, 1.0f);
 glm::vec3 objectColor = glm::vec3(0.8f, 0.5f, 0.2f);
 int renderMode = 0; // 0 = plein, 1 = filaire
 
+CurveSpatialIndex spatialIndex;
+const float pickPixels = 8.0f; // rayon de sélection autour du curseur
+ControlPointRef hoveredPoint;
+ControlPointRef draggedPoint;
+
+// Trait à main levée (Maj + glisser) : ajusté en cubiques au relâchement
+bool drawingStroke = false;
+std::vector<glm::vec2> strokePoints;
+float strokePixels = 1.5f; // écart maximal entre le trait et les cubiques, en pixels
+std::size_t lastStrokeInput = 0, lastStrokeSegments = 0;
+
+bool showIntersections = false;
+std::vector<CurveIntersection> intersections;
+std::vector<std::uint64_t> intersectionVersions; // versions des courbes au dernier calcul
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
 
+// Position du curseur dans le repère [-1, 1] de l'affichage 2D
+glm::vec2 cursorToScene(GLFWwindow* window, double xpos, double ypos) {
+    int width, height;
+    glfwGetWindowSize(window, &width, &height);
+    float x = (2.0f * xpos) / width - 1.0f;
+    float y = 1.0f - (2.0f * ypos) / height;
+    return glm::vec2(x, y);
+}
+
+float pickRadius(GLFWwindow* window) {
+    int width, height;
+    glfwGetWindowSize(window, &width, &height);
+    return pickPixels * 2.0f / (float)std::max(std::max(width, height), 1);
+}
+
+SamplingOptions currentSampling();
+
+// Chaque cubique de l'ajustement devient une courbe, raccordée C1 à la précédente
+void finishStroke(GLFWwindow* window) {
+    drawingStroke = false;
+    int width, height;
+    glfwGetWindowSize(window, &width, &height);
+    const float tolerance = strokePixels * 2.0f / (float)std::max(std::max(width, height), 1);
+    CompositeBezier fitted = CompositeBezier::fit(strokePoints, tolerance);
+    lastStrokeInput = strokePoints.size();
+    lastStrokeSegments = fitted.segmentCount();
+    strokePoints.clear();
+    if (fitted.segments.empty()) return;
+    for (auto& segment : fitted.segments) curves.push_back(std::move(segment));
+    currentCurveIndex = (int)curves.size() - 1;
+}
+
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_MIDDLE) {
         rotating = (action == GLFW_PRESS);
@@ -44,23 +114,57 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
         camera.lastX = (float)x;
         camera.lastY = (float)y;
     }
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && !ImGui::GetIO().WantCaptureMouse) {
-        double xpos, ypos;
-        glfwGetCursorPos(window, &xpos, &ypos);
-        int width, height;
-        glfwGetWindowSize(window, &width, &height);
-        float x = (2.0f * xpos) / width - 1.0f;
-        float y = 1.0f - (2.0f * ypos) / height;
-        if (currentCurveIndex != -1) {
-            curves[currentCurveIndex].controlPoints.push_back(glm::vec2(x, y));
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE) {
+        draggedPoint = ControlPointRef();
+        if (drawingStroke) finishStroke(window);
+    }
+    if (ImGui::GetIO().WantCaptureMouse || action != GLFW_PRESS) return;
+
+    double xpos, ypos;
+    glfwGetCursorPos(window, &xpos, &ypos);
+    glm::vec2 cursor = cursorToScene(window, xpos, ypos);
+
+    if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        // Ctrl + clic : déplacer le point de contrôle sous le curseur au lieu d'en ajouter un
+        ControlPointRef picked;
+        if (mods & GLFW_MOD_SHIFT) {
+            drawingStroke = true;
+            strokePoints.assign(1, cursor);
+        } else if ((mods & GLFW_MOD_CONTROL) && spatialIndex.nearestControlPoint(cursor, pickRadius(window), picked)) {
+            draggedPoint = picked;
+            currentCurveIndex = picked.curve;
+            curves[picked.curve].bake(); // le curseur est en coordonnées monde
+        } else if (currentCurveIndex != -1) {
+            curves[currentCurveIndex].addControlPoint(cursor);
         }
     }
+    if (button == GLFW_MOUSE_BUTTON_RIGHT) {
+        // Clic droit : la courbe la plus proche devient la courbe active
+        int picked = spatialIndex.nearestCurve(curves, currentSampling(), cursor, pickRadius(window));
+        if (picked >= 0) currentCurveIndex = picked;
+    }
 }
 
 void cursor_position_callback(GLFWwindow* window, double xpos, double ypos) {
     if (rotating) {
         camera.processMouseMovement((float)xpos, (float)ypos);
     }
+
+    glm::vec2 cursor = cursorToScene(window, xpos, ypos);
+    if (drawingStroke) {
+        if (cursor != strokePoints.back()) strokePoints.push_back(cursor);
+        return;
+    }
+    if (draggedPoint.curve >= 0) {
+        BezierCurveData& curve = curves[draggedPoint.curve];
+        curve.controlPoints[draggedPoint.point] = cursor;
+        curve.markModified();
+        return;
+    }
+
+    spatialIndex.update(curves);
+    hoveredPoint = ControlPointRef();
+    spatialIndex.nearestControlPoint(cursor, pickRadius(window), hoveredPoint);
 }
 
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
@@ -79,26 +183,70 @@ void processInput(GLFWwindow* window) {
         camera.processPan(0, 1.0f * panAmount);
 }
 
-std::vector<glm::vec2> generateCurvePoints(const BezierCurveData& curve, BezierMethod method, int p_courbe) {
-    std::vector<glm::vec2> result;
-    if (curve.controlPoints.size() < 2) return {};
-    for (int i = 0; i <= p_courbe; ++i) {
-        float t = i / (float)p_courbe;
-        result.push_back(curve.evaluate(t, method));
-    }
-    return result;
+// Réglages courants ; la tolérance en pixels est convertie dans le repère [-1, 1] de l'affichage 2D
+SamplingOptions currentSampling() {
+    SamplingOptions options;
+    options.mode = samplingMode;
+    options.method = currentMethod;
+    options.segments = p_courbe;
+    int width = WIDTH, height = HEIGHT;
+    if (window) glfwGetWindowSize(window, &width, &height);
+    options.tolerance = flatnessPixels * 2.0f / (float)std::max(std::max(width, height), 1);
+    return options;
 }
 
-std::vector<glm::vec3> generateGeneralPath() {
-    std::vector<glm::vec3> path;
-    for (int i = 0; i < 100; ++i) {
-        float t = i / 99.0f;
-        float x = t * 2.0f - 1.0f;
-        float y = 0.0f;
-        float z = sinf(t * 4.0f * 3.1415f) * 0.2f;
-        path.push_back(glm::vec3(x, y, z));
+// Polyligne mise en cache par la courbe, partagée entre l'affichage et les extrusions. Le cache
+// est rééchantillonné sur place : une fois à sa taille, une image n'alloue plus rien
+// (bench/check_frame_allocations.cpp le vérifie).
+const std::vector<glm::vec2>& generateCurvePoints(const BezierCurveData& curve, const SamplingOptions& options) {
+    return curve.sampled(options);
+}
+
+const std::vector<glm::vec2>& generateCurvePoints(const BSplineCurve& curve, const SamplingOptions& options) {
+    return curve.sampled(options);
+}
+
+// Recopie les points de la courbe active dans la B-spline : un déplacement ne touche qu'un point,
+// donc seuls ses intervalles sont rééchantillonnés ; un ajout reconstruit tout.
+void syncSplineProfile(const BezierCurveData& curve) {
+    splineCurve.setDegree(splineDegree);
+    const auto& pts = curve.worldControlPoints();
+    if (splineCurve.points().size() != pts.size()) {
+        splineCurve.clear();
+        for (const auto& pt : pts) splineCurve.addControlPoint(pt);
+        return;
     }
-    return path;
+    for (std::size_t i = 0; i < pts.size(); ++i) splineCurve.setControlPoint(i, pts[i]);
+}
+
+// Chemin 3D de l'extrusion généralisée : l'ancienne sinusoïde x = 2t - 1, z = 0.2 sin(4πt)
+// (deux périodes), en Bézier de degré 11. Les x équirépartis donnent x(t) = 2t - 1 exactement ;
+// les z sont ajustés aux moindres carrés, extrémités fixées à 0 (écart maximal < 2e-4).
+BezierCurve3f makeSweepPath() {
+    const float z[] = {0.0f, 0.2258f, 0.4824f, 0.1516f, -0.2109f, -3.0521f,
+                       3.0521f, 0.2109f, -0.1516f, -0.4824f, -0.2258f, 0.0f};
+    const int degree = 11;
+    std::vector<glm::vec3> points(degree + 1);
+    for (int i = 0; i <= degree; ++i) points[i] = glm::vec3(-1.0f + 2.0f * i / degree, 0.0f, z[i]);
+    return BezierCurve3f(std::move(points));
+}
+
+BezierCurve3f sweepPath = makeSweepPath();
+
+void generateGeneralPath(std::vector<glm::vec3>& path) {
+    path.resize(100);
+    sweepPath.sampleUniform((int)path.size() - 1, path.data());
+}
+
+// Recalcule les intersections seulement si une courbe a été ajoutée ou modifiée
+void updateIntersections() {
+    bool changed = intersectionVersions.size() != curves.size();
+    for (std::size_t i = 0; i < curves.size() && !changed; ++i)
+        changed = intersectionVersions[i] != curves[i].version();
+    if (!changed) return;
+    intersectionVersions.resize(curves.size());
+    for (std::size_t i = 0; i < curves.size(); ++i) intersectionVersions[i] = curves[i].version();
+    intersections = intersectAll(curves);
 }
 
 void drawCurve2D() {
@@ -111,8 +259,11 @@ void drawCurve2D() {
     glPushMatrix();
     glLoadIdentity();
 
+    // Les courbes modifiées sont rééchantillonnées en parallèle, les autres restent en cache
+    const SamplingOptions sampling = currentSampling();
+    refreshSampleCaches(curves, sampling);
     for (int i = 0; i < curves.size(); ++i) {
-        auto pts = generateCurvePoints(curves[i], currentMethod, p_courbe);
+        const auto& pts = generateCurvePoints(curves[i], sampling);
         glColor3f(1.0f, 1.0f, 0.0f);
         glBegin(GL_LINE_STRIP);
         for (auto& pt : pts) glVertex2f(pt.x, pt.y);
@@ -120,7 +271,42 @@ void drawCurve2D() {
 
         glPointSize(5.0f);
         glBegin(GL_POINTS);
-        for (auto& pt : curves[i].controlPoints) glVertex2f(pt.x, pt.y);
+        for (auto& pt : curves[i].worldControlPoints()) glVertex2f(pt.x, pt.y);
+        glEnd();
+    }
+
+    const ControlPointRef& highlighted = (draggedPoint.curve >= 0) ? draggedPoint : hoveredPoint;
+    if (highlighted.curve >= 0 && highlighted.curve < (int)curves.size() &&
+        highlighted.point < (int)curves[highlighted.curve].controlPoints.size()) {
+        const glm::vec2& pt = curves[highlighted.curve].worldControlPoints()[highlighted.point];
+        glColor3f(1.0f, 0.3f, 0.3f);
+        glPointSize(9.0f);
+        glBegin(GL_POINTS);
+        glVertex2f(pt.x, pt.y);
+        glEnd();
+    }
+
+    if (splineProfile && currentCurveIndex >= 0 && currentCurveIndex < (int)curves.size()) {
+        syncSplineProfile(curves[currentCurveIndex]);
+        glColor3f(1.0f, 0.4f, 1.0f);
+        glBegin(GL_LINE_STRIP);
+        for (auto& pt : generateCurvePoints(splineCurve, sampling)) glVertex2f(pt.x, pt.y);
+        glEnd();
+    }
+
+    if (drawingStroke) {
+        glColor3f(0.6f, 0.6f, 0.6f);
+        glBegin(GL_LINE_STRIP);
+        for (auto& pt : strokePoints) glVertex2f(pt.x, pt.y);
+        glEnd();
+    }
+
+    if (showIntersections) {
+        updateIntersections();
+        glColor3f(0.2f, 1.0f, 1.0f);
+        glPointSize(7.0f);
+        glBegin(GL_POINTS);
+        for (const auto& hit : intersections) glVertex2f(hit.point.x, hit.point.y);
         glEnd();
     }
 
@@ -129,20 +315,54 @@ void drawCurve2D() {
     glPopMatrix();
 }
 
-void drawMesh(const Mesh& mesh) {
+const InterleavedMesh& shownMesh() {
+    switch (shownExtrusion) {
+        case ExtrusionKind::Revolution: return revolutionExtrusion.mesh();
+        case ExtrusionKind::Sweep: return sweepExtrusion.mesh();
+        default: return linearExtrusion.mesh();
+    }
+}
+
+std::size_t lastRewrittenVertices() {
+    switch (shownExtrusion) {
+        case ExtrusionKind::Revolution: return revolutionExtrusion.lastRewrittenVertices();
+        case ExtrusionKind::Sweep: return sweepExtrusion.lastRewrittenVertices();
+        default: return linearExtrusion.lastRewrittenVertices();
+    }
+}
+
+// Tableaux de sommets sur le tampon entrelacé : pas de recopie ni d'appel par sommet
+void drawMesh(const InterleavedMesh& mesh) {
+    if (mesh.empty() || mesh.indexCount() == 0) return;
+    const GLsizei stride = (GLsizei)mesh.stride();
     glPushMatrix();
     glColor3f(objectColor.r, objectColor.g, objectColor.b);
-    glBegin(GL_TRIANGLES);
-    for (size_t i = 0; i < mesh.indices.size(); ++i) {
-        unsigned int idx = mesh.indices[i];
-        if (idx < mesh.normals.size()) {
-            const glm::vec3& normal = mesh.normals[idx];
-            glNormal3f(normal.x, normal.y, normal.z);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, mesh.data());
+    if (InterleavedMesh::hasNormals(mesh.format)) {
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glNormalPointer(GL_FLOAT, stride, mesh.data() + InterleavedMesh::normalOffset);
+    }
+    const GLenum type = (mesh.indexType == IndexType::UInt16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    if (mesh.primitive == Primitive::Triangles) {
+        glDrawElements(GL_TRIANGLES, (GLsizei)mesh.indexCount(), type, mesh.indexData());
+    } else if (GLAD_GL_VERSION_3_1) {
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(mesh.restartIndex());
+        glDrawElements(GL_TRIANGLE_STRIP, (GLsizei)mesh.indexCount(), type, mesh.indexData());
+        glDisable(GL_PRIMITIVE_RESTART);
+    } else {
+        // Sans redémarrage de primitive (GL < 3.1) : une bande par appel
+        const char* base = static_cast<const char*>(mesh.indexData());
+        std::size_t start = 0;
+        for (std::size_t k = 0; k <= mesh.indexCount(); ++k) {
+            if (k < mesh.indexCount() && mesh.index(k) != mesh.restartIndex()) continue;
+            glDrawElements(GL_TRIANGLE_STRIP, (GLsizei)(k - start), type, base + start * mesh.indexSize());
+            start = k + 1;
         }
-        const glm::vec3& v = mesh.vertices[idx];
-        glVertex3f(v.x, v.y, v.z);
     }
-    glEnd();
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
     glPopMatrix();
 }
 
@@ -202,6 +422,7 @@ int main() {
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         processInput(window);
+        spatialIndex.update(curves);
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
@@ -211,11 +432,44 @@ int main() {
             currentMethod = BezierMethod::DeCasteljau;
         if (ImGui::RadioButton("Formule directe", currentMethod == BezierMethod::DirectFormula))
             currentMethod = BezierMethod::DirectFormula;
+        if (ImGui::RadioButton("Différences avant", currentMethod == BezierMethod::ForwardDifference))
+            currentMethod = BezierMethod::ForwardDifference;
+        if (ImGui::RadioButton("Horner", currentMethod == BezierMethod::Horner))
+            currentMethod = BezierMethod::Horner;
+        if (ImGui::RadioButton("SIMD", currentMethod == BezierMethod::Simd))
+            currentMethod = BezierMethod::Simd;
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%s)", simdLevelName(detectSimdLevel()));
+
+        if (ImGui::RadioButton("t uniforme", samplingMode == SamplingMode::Uniform))
+            samplingMode = SamplingMode::Uniform;
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Adaptatif", samplingMode == SamplingMode::Adaptive))
+            samplingMode = SamplingMode::Adaptive;
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Longueur", samplingMode == SamplingMode::ArcLength))
+            samplingMode = SamplingMode::ArcLength;
+        if (samplingMode == SamplingMode::Adaptive)
+            ImGui::SliderFloat("Tolérance (px)", &flatnessPixels, 0.05f, 5.0f);
+        else
+            ImGui::SliderInt("Echantillons", &p_courbe, 2, 500);
+
+        const SampleCacheStats cacheStats = BezierCurveData::sampleCacheStats();
+        ImGui::Text("Cache polylignes : %zu succès / %zu échecs", cacheStats.hits, cacheStats.misses);
 
         if (ImGui::Button("Nouvelle courbe")) {
             curves.emplace_back();
             currentCurveIndex = (int)curves.size() - 1;
         }
+        ImGui::SameLine();
+        ImGui::Checkbox("Intersections", &showIntersections);
+        ImGui::SliderFloat("Tolérance trait (px)", &strokePixels, 0.25f, 10.0f);
+        if (lastStrokeInput > 0)
+            ImGui::TextDisabled("Trait (Maj + glisser) : %zu points -> %zu cubiques", lastStrokeInput, lastStrokeSegments);
+        if (showIntersections) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%zu)", intersections.size());
+        }
 
         if (currentCurveIndex >= 0 && currentCurveIndex < curves.size()) {
             ImGui::Text("Courbe active : %d", currentCurveIndex);
@@ -224,25 +478,73 @@ int main() {
             if (ImGui::Button("Fermer C1")) curves[currentCurveIndex].closeCurveC1();
             ImGui::SameLine();
             if (ImGui::Button("Fermer C2")) curves[currentCurveIndex].closeCurveC2();
+            // Transformations différées : composées dans la matrice de la courbe, sans réécrire ses points
+            BezierCurveData& active = curves[currentCurveIndex];
+            if (ImGui::Button("Tourner 15°"))
+                active.applyTransformation(glm::mat3(glm::rotate(glm::mat4(1.0f), glm::radians(15.0f), glm::vec3(0, 0, 1))));
+            ImGui::SameLine();
+            if (ImGui::Button("Agrandir")) active.applyTransformation(glm::mat3(glm::scale(glm::mat4(1.0f), glm::vec3(1.1f))));
+            ImGui::SameLine();
+            if (ImGui::Button("Réduire")) active.applyTransformation(glm::mat3(glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / 1.1f))));
+            if (active.hasTransformation()) {
+                ImGui::SameLine();
+                if (ImGui::Button("Figer")) active.bake();
+            }
         }
 
-        ImGui::SliderFloat("Hauteur", &height, 0.1f, 5.0f);
-        ImGui::SliderFloat("Echelle top", &scaleTop, 0.1f, 2.0f);
-        ImGui::SliderInt("Révol. segments", &slices, 3, 100);
+        // Régénération en direct : seuls les sommets touchés par le paramètre sont réécrits
+        const bool heightMoved = ImGui::SliderFloat("Hauteur", &height, 0.1f, 5.0f);
+        const bool scaleMoved = ImGui::SliderFloat("Echelle top", &scaleTop, 0.1f, 2.0f);
+        if ((heightMoved || scaleMoved) && shownExtrusion == ExtrusionKind::Linear)
+            linearExtrusion.update(height, scaleTop);
+        if (ImGui::SliderInt("Révol. segments", &slices, 3, 100) && shownExtrusion == ExtrusionKind::Revolution)
+            revolutionExtrusion.update(slices);
         ImGui::Checkbox("Mode révolution", &revolutionMode);
         ImGui::Checkbox("Mode généralisé", &generalizedMode);
+        ImGui::Checkbox("Profil en cubiques", &cubicProfile);
+        if (cubicProfile && cubicSegmentCount > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%d segments)", cubicSegmentCount);
+        }
+        ImGui::Checkbox("Profil B-spline", &splineProfile);
+        if (splineProfile) {
+            ImGui::SliderInt("Degré B-spline", &splineDegree, 1, BSplineCurve::kMaxDegree);
+            ImGui::TextDisabled("(%zu intervalles recalculés)", splineCurve.lastResampledSpans());
+        }
 
         if (ImGui::Button("Générer extrusion") && currentCurveIndex != -1) {
-            auto profile2D = generateCurvePoints(curves[currentCurveIndex], currentMethod, p_courbe);
-            if (revolutionMode)
-                extrudedMesh = extrudeRevolution(profile2D, slices);
-            else if (generalizedMode)
-                extrudedMesh = extrudeGeneralized(profile2D, generateGeneralPath());
-            else
-                extrudedMesh = extrudeLinear(profile2D, height, scaleTop);
+            const BezierCurveData& profile = curves[currentCurveIndex];
+            const SamplingOptions sampling = currentSampling();
+            const std::vector<glm::vec2>* points = nullptr;
+            if (splineProfile) {
+                syncSplineProfile(profile);
+                points = &generateCurvePoints(splineCurve, sampling);
+            } else if (cubicProfile) {
+                // Profil converti en segments cubiques : le coût ne dépend plus du degré de la courbe
+                CompositeBezier cubic = CompositeBezier::fromCurve(profile, sampling.tolerance);
+                cubic.sample(sampling, cubicProfilePoints);
+                cubicSegmentCount = (int)cubic.segmentCount();
+                points = &cubicProfilePoints;
+            } else
+                points = &generateCurvePoints(profile, sampling);
+
+            if (revolutionMode) {
+                revolutionExtrusion.update(*points, slices);
+                shownExtrusion = ExtrusionKind::Revolution;
+            } else if (generalizedMode) {
+                generateGeneralPath(sweepPathPoints);
+                sweepExtrusion.update(*points, sweepPathPoints);
+                shownExtrusion = ExtrusionKind::Sweep;
+            } else {
+                linearExtrusion.update(*points, height, scaleTop);
+                shownExtrusion = ExtrusionKind::Linear;
+            }
             showExtrusion = true;
         }
 
+        if (showExtrusion) {
+            ImGui::TextDisabled("(%zu sommets recalculés sur %zu)", lastRewrittenVertices(), shownMesh().vertexCount());
+        }
         ImGui::Checkbox("Afficher extrusion", &showExtrusion);
         ImGui::SeparatorText("Lumière");
         ImGui::SliderFloat3("Position lumière", &lightPosition.x, -5.0f, 5.0f);
@@ -271,7 +573,7 @@ int main() {
         drawAxes();
 
         if (showExtrusion)
-            drawMesh(extrudedMesh);
+            drawMesh(shownMesh());
 
         drawCurve2D();
 